@@ -0,0 +1,373 @@
+#include "../lib/lp_solver.hpp"
+#include <filesystem>
+#include <random>
+#include <csignal>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+// time limit of one run in seconds (--timeout)
+#define TIMEOUT 600
+
+// directories whose examples are solved when no problem is given
+const std::vector<std::string> EXAMPLE_DIRS = {
+    "../Simplex/examples",
+    "../Residual Simplex/examples",
+    "../Two-Phase Simplex and Dual Simplex/case1/examples"
+};
+
+// Problem is file (path) or random model (rows x cols with given density and seed)
+// Model is read/generated in child process, so parent process never keeps model in memory
+struct Problem {
+    std::string name;
+    std::string path;
+    unsigned rows = 0, cols = 0;
+    double density = 1.0;
+    unsigned seed = 0;
+};
+
+// Engine ~ Solver with method and options
+struct Engine {
+    std::string name;
+    SolverMethod method;
+    bool scaling, crossover;
+};
+
+// primal    ~ Simplex program: crash base + residual simplex (eta file), scaled system
+// residual  ~ Residual Simplex program: same engine without scaling
+// two-phase ~ phase one with artificial variables + phase two
+// composite ~ single phase: artificial variables + weighted cost, then phase two
+// dual      ~ dual simplex from slack base
+// barrier   ~ interior point method + crossover
+// concurrent is run only if it is asked for (--engines)
+const std::vector<Engine> ENGINES = {
+    {"primal", SolverMethod::PRIMAL, true, false},
+    {"residual", SolverMethod::PRIMAL, false, false},
+    {"two-phase", SolverMethod::TWO_PHASE, false, false},
+    {"composite", SolverMethod::COMPOSITE, false, false},
+    {"dual", SolverMethod::DUAL, true, false},
+    {"barrier", SolverMethod::BARRIER, true, true},
+    {"concurrent", SolverMethod::CONCURRENT, true, true}
+};
+
+// Random feasible and bounded LP: (min) c*x, x >= 0
+// Every 5th row is covering row (A(i)*x > b(i)), others are packing rows (A(i)*x < b(i)),
+// all values of A are positive and x0 (0 <= x0(j) <= 5) is feasible point:
+// packing row: b(i) = A(i)*x0 + slack (1 <= slack <= 5), covering row: b(i) = 0.9*A(i)*x0
+// Every column has value in some packing row so system is bounded (c has both signs)
+// Row has round(density*N) values (at least 1), density 1 gives dense model
+LPModel random_model(unsigned rows, unsigned cols, double density, unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> value(1.0, 10.0), point(0.0, 5.0), slack(1.0, 5.0), cost(-10.0, 10.0);
+    std::uniform_int_distribution<unsigned> column(0, cols-1);
+
+    LPModel model;
+    model.name = "random";
+    std::vector<double> x0(cols);
+    for(unsigned j=0; j<cols; j++)
+    {
+        model.col_names.push_back("x" + std::to_string(j));
+        model.c.push_back(cost(generator));
+        model.lower.push_back(0.0);
+        model.upper.push_back(LP_INF);
+        model.is_integer.push_back(false);
+        x0.at(j) = point(generator);
+    }
+
+    // Step1: values of rows (same column can be chosen twice, values are added)
+    std::vector<Triplet> triplets;
+    std::vector<bool> covered(cols, false);
+    std::vector<unsigned> packing;
+    unsigned count = std::max(1u, (unsigned)std::lround(density*cols));
+    for(unsigned i=0; i<rows; i++)
+    {
+        char sense = (i%5 == 4) ? '>' : '<';
+        model.row_names.push_back("r" + std::to_string(i));
+        model.sense.push_back(sense);
+        if(sense == '<')
+            packing.push_back(i);
+        for(unsigned k=0; k<count; k++)
+        {
+            unsigned j = (count >= cols) ? k : column(generator);
+            triplets.push_back({i, j, std::round(value(generator))});
+            if(sense == '<')
+                covered.at(j) = true;
+        }
+    }
+
+    // Step2: columns without values in packing rows get value in random packing row
+    std::uniform_int_distribution<unsigned> packing_row(0, packing.size()-1);
+    for(unsigned j=0; j<cols; j++)
+        if(!covered.at(j))
+            triplets.push_back({packing.at(packing_row(generator)), j, std::round(value(generator))});
+
+    // Step3: b from feasible point x0
+    std::vector<double> activity(rows, 0.0);
+    for(const auto& t: triplets)
+        activity.at(t.row) += t.value*x0.at(t.col);
+    for(unsigned i=0; i<rows; i++)
+    {
+        model.rhs.push_back((model.sense.at(i) == '<') ? activity.at(i) + slack(generator) : 0.9*activity.at(i));
+        model.range.push_back(LP_INF);
+    }
+    model.A = SparseMatrix(rows, cols, triplets);
+
+    return model;
+}
+
+// Child process: problem is loaded and solved with engine, result is written to fd as one line:
+// rows cols nonzeros status objective seconds iterations pivots bound_flips factorizations
+// (seconds ~ wall time of solve, reading/generating model is not measured)
+void run_child(const Problem& problem, const Engine& engine, int fd)
+{
+    std::ostringstream line;
+    line << std::setprecision(12);
+    try
+    {
+        LPModel model;
+        ReadStats stats;
+        if(problem.path.empty())
+            model = random_model(problem.rows, problem.cols, problem.density, problem.seed);
+        else
+            model = read_model(problem.path, false, stats);
+
+        Solver solver;
+        solver.load(model);
+        solver.set_method(engine.method);
+        solver.set_scaling(engine.scaling);
+        solver.set_crossover(engine.crossover);
+
+        auto start = std::chrono::steady_clock::now();
+        auto status = solver.solve();
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+        const auto& work = solver.counters();
+        line << model.rows() << " " << model.cols() << " " << model.A.nonzeros() << " " << to_string(status) << " ";
+        if(status == SolverStatus::OPTIMAL)
+            line << solver.objective();
+        else
+            line << "-";
+        line << " " << seconds.count() << " " << work.iterations << " " << work.pivots << " "
+             << work.bound_flips << " " << work.factorizations << std::endl;
+    }
+    catch(const std::exception& e)
+    {
+        line << "- - - error - - - - - -" << std::endl;
+    }
+
+    std::string text = line.str();
+    if(write(fd, text.data(), text.size()) < 0)
+        _exit(1);
+}
+
+// field with ',' or '"' is quoted ('"' is written as "")
+std::string csv_field(const std::string& text)
+{
+    if(text.find_first_of(",\"") == std::string::npos)
+        return text;
+    std::string quoted = "\"";
+    for(char ch: text)
+        quoted += (ch == '"') ? std::string("\"\"") : std::string(1, ch);
+    return quoted + "\"";
+}
+
+// Every run is done in its own process (fork): peak RSS of run is ru_maxrss of child
+// (wait4), crash or timeout of one run does not stop benchmark
+// Child gets SIGALRM after timeout seconds
+std::string run(const Problem& problem, const Engine& engine, unsigned timeout, const std::string& tag)
+{
+    int fds[2];
+    if(pipe(fds) != 0)
+        return "";
+    std::cout.flush();
+    pid_t pid = fork();
+    if(pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return "";
+    }
+    if(pid == 0)
+    {
+        close(fds[0]);
+        alarm(timeout);
+        run_child(problem, engine, fds[1]);
+        close(fds[1]);
+        _exit(0);
+    }
+
+    close(fds[1]);
+    std::string text;
+    char buffer[256];
+    ssize_t size;
+    while((size = read(fds[0], buffer, sizeof(buffer))) > 0)
+        text.append(buffer, size);
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+
+    // rows cols nonzeros status objective seconds iterations pivots bound_flips factorizations
+    std::vector<std::string> fields;
+    std::istringstream in(text);
+    std::string field;
+    while(in >> field)
+        fields.push_back(field == "-" ? "" : field);
+    if(fields.size() != 10)
+    {
+        // random model has known size, size of file is unknown if child did not finish
+        std::string state = (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) ? "timeout" : "crashed";
+        fields.assign(10, "");
+        if(problem.path.empty())
+        {
+            fields.at(0) = std::to_string(problem.rows);
+            fields.at(1) = std::to_string(problem.cols);
+        }
+        fields.at(3) = state;
+    }
+
+    std::ostringstream line;
+    line << csv_field(tag) << "," << engine.name << "," << csv_field(problem.name);
+    for(const auto& value: fields)
+        line << "," << value;
+    line << "," << usage.ru_maxrss;
+    return line.str();
+}
+
+// "MxN" or "MxN:DENSITY" (ex. 2000x3000:0.001)
+bool parse_random(const std::string& text, unsigned seed, Problem& problem)
+{
+    unsigned rows = 0, cols = 0;
+    double density = 1.0;
+    char x = 0, colon = 0;
+    std::istringstream in(text);
+    if(!(in >> rows >> x >> cols) || x != 'x' || rows == 0 || cols == 0)
+        return false;
+    if(in >> colon)
+        if(colon != ':' || !(in >> density) || density <= 0.0 || density > 1.0)
+            return false;
+
+    problem.rows = rows;
+    problem.cols = cols;
+    problem.density = density;
+    problem.seed = seed;
+    auto colon_at = text.find(':');
+    std::string density_text = (colon_at == std::string::npos) ? "1" : text.substr(colon_at+1);
+    problem.name = "random_" + std::to_string(rows) + "x" + std::to_string(cols) + "_d" + density_text + "_s" + std::to_string(seed);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    // Options:
+    // --tag TAG           ~ first column of every line (ex. commit: --tag $(git rev-parse --short HEAD))
+    // --engines E1,E2,... ~ engines to run (default: primal,residual,two-phase,composite,dual,barrier)
+    // --random MxN[:D]    ~ random model with M rows, N columns and density D (can be repeated)
+    // --seed S            ~ seed of next random models (default 1)
+    // --repeat K          ~ every random model is generated with seeds S, S+1, ..., S+K-1
+    // --timeout T         ~ time limit of one run in seconds (default 600)
+    // other arguments are problem files (.txt, .mps, .lp)
+    // Without files and random models examples of LP programs and two random models are solved
+    std::string tag;
+    std::vector<std::string> engine_names = {"primal", "residual", "two-phase", "composite", "dual", "barrier"};
+    std::vector<Problem> files, randoms;
+    unsigned seed = 1, repeat = 1, timeout = TIMEOUT;
+    for(int i=1; i<argc; i++)
+    {
+        std::string arg(argv[i]);
+        if(arg == "--tag" && i+1 < argc)
+            tag = argv[++i];
+        else if(arg == "--engines" && i+1 < argc)
+        {
+            engine_names.clear();
+            std::istringstream in(argv[++i]);
+            std::string name;
+            while(std::getline(in, name, ','))
+                engine_names.push_back(name);
+        }
+        else if(arg == "--random" && i+1 < argc)
+        {
+            std::string spec = argv[++i];
+            for(unsigned k=0; k<repeat; k++)
+            {
+                Problem problem;
+                if(!parse_random(spec, seed+k, problem))
+                {
+                    std::cerr << "Invalid random model \"" << spec << "\" (MxN or MxN:DENSITY)!" << std::endl;
+                    return 1;
+                }
+                randoms.push_back(problem);
+            }
+        }
+        else if(arg == "--seed" && i+1 < argc)
+            seed = std::stoi(argv[++i]);
+        else if(arg == "--repeat" && i+1 < argc)
+            repeat = std::max(1, std::stoi(argv[++i]));
+        else if(arg == "--timeout" && i+1 < argc)
+            timeout = std::stoi(argv[++i]);
+        else
+        {
+            Problem problem;
+            problem.name = problem.path = arg;
+            files.push_back(problem);
+        }
+    }
+
+    std::vector<Engine> engines;
+    for(const auto& name: engine_names)
+    {
+        auto it = std::find_if(ENGINES.begin(), ENGINES.end(), [&](const Engine& engine) { return engine.name == name; });
+        if(it == ENGINES.end())
+        {
+            std::cerr << "Unknown engine \"" << name << "\"!" << std::endl;
+            return 1;
+        }
+        engines.push_back(*it);
+    }
+
+    // Default corpus: examples (sorted by name) + dense and sparse random model
+    if(files.empty() && randoms.empty())
+    {
+        for(const auto& dir: EXAMPLE_DIRS)
+        {
+            std::vector<std::string> paths;
+            std::error_code error;
+            for(const auto& entry: std::filesystem::directory_iterator(dir, error))
+                if(entry.is_regular_file())
+                    paths.push_back(entry.path().string());
+            std::sort(paths.begin(), paths.end());
+            for(const auto& path: paths)
+            {
+                Problem problem;
+                problem.name = problem.path = path;
+                files.push_back(problem);
+            }
+        }
+        for(std::string spec: {"50x80", "100x150:0.05"})
+        {
+            Problem problem;
+            parse_random(spec, seed, problem);
+            randoms.push_back(problem);
+        }
+    }
+    std::vector<Problem> problems = files;
+    problems.insert(problems.end(), randoms.begin(), randoms.end());
+
+    // CSV: one line per (problem, engine), lines are written as runs end
+    std::cout << "tag,engine,problem,rows,cols,nonzeros,status,objective,seconds,iterations,pivots,bound_flips,factorizations,peak_rss_kb" << std::endl;
+    for(const auto& problem: problems)
+        for(const auto& engine: engines)
+        {
+            auto line = run(problem, engine, timeout, tag);
+            if(line.empty())
+            {
+                std::cerr << "Failed to start run (" << engine.name << ", " << problem.name << ")!" << std::endl;
+                return 1;
+            }
+            std::cout << line << std::endl;
+        }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "../lib/mip.hpp"
+
+int main(int argc, char** argv)
+{
+    std::cout << std::fixed;
+    std::cout << std::setprecision(2);
+
+    // *INPUT*
+    // [--threads T] [--time-limit S] [--node-limit K] [--gap G] [--cuts LIST] [--no-cuts] [--no-heuristics] [file]
+    // LIST ~ cut families separated by commas: gomory, gmi, mir, cover (default cover,mir,gmi)
+    const char* path = "input.txt";
+    MipOptions options;
+    options.log = &std::cout;
+    try
+    {
+        for(int i=1; i<argc; i++)
+        {
+            std::string arg = argv[i];
+            if(arg == "--threads" && i+1 < argc)
+                options.threads = std::stoul(argv[++i]);
+            else if(arg == "--time-limit" && i+1 < argc)
+                options.time_limit = std::stod(argv[++i]);
+            else if(arg == "--node-limit" && i+1 < argc)
+                options.node_limit = std::stoul(argv[++i]);
+            else if(arg == "--gap" && i+1 < argc)
+                options.gap = std::stod(argv[++i]);
+            else if(arg == "--cuts" && i+1 < argc)
+            {
+                options.cut_families.clear();
+                std::stringstream list(argv[++i]);
+                std::string name;
+                while(std::getline(list, name, ','))
+                {
+                    bool known = false;
+                    for(auto family: {CutFamily::GOMORY, CutFamily::GMI, CutFamily::MIR, CutFamily::COVER})
+                        if(name == to_string(family))
+                        {
+                            options.cut_families.push_back(family);
+                            known = true;
+                        }
+                    if(!known)
+                        throw std::invalid_argument(name);
+                }
+            }
+            else if(arg == "--no-cuts")
+                options.cuts = false;
+            else if(arg == "--no-heuristics")
+                options.heuristics = false;
+            else
+                path = argv[i];
+        }
+    }
+    catch(const std::logic_error& e)
+    {
+        std::cout << "Invalid option value!" << std::endl;
+        return 1;
+    }
+
+    // *TASK INPUT*
+    LPModel model;
+    ReadStats stats;
+    try
+    {
+        model = read_model(path, false, stats);
+    }
+    catch(const std::runtime_error& e)
+    {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+
+    // .txt files (and models without integer markers) have no integer variables: all are integer
+    bool marked = false;
+    for(unsigned j=0; j<model.cols(); j++)
+        marked = marked || model.is_integer.at(j);
+    if(!marked)
+    {
+        std::cout << "There are no integer markers, all variables are integer." << std::endl;
+        model.is_integer.assign(model.cols(), true);
+    }
+
+    // *BRANCH AND BOUND*
+    MipResult result;
+    try
+    {
+        result = branch_and_bound(model, options);
+    }
+    catch(const std::invalid_argument& e)
+    {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << BAR << std::endl;
+    std::cout << "Nodes: " << result.nodes << " (" << result.threads << " threads, " << result.steals
+              << " stolen), pivots: " << result.pivots << ", root cuts: " << result.cuts << ", "
+              << result.seconds << " s" << std::endl;
+    for(const auto& cuts: result.cut_stats)
+        if(cuts.rounds > 0)
+            std::cout << to_string(cuts.family) << " cuts: " << cuts.candidates << " candidates, " << cuts.filtered
+                      << " passed filter, " << cuts.added << " added, bound gain " << cuts.gain << ", "
+                      << cuts.seconds*1000 << " ms" << std::endl;
+    for(const auto& heuristic: result.heuristics)
+        if(heuristic.calls > 0)
+            std::cout << heuristic.name << ": " << heuristic.calls << " calls, " << heuristic.found << " solutions, "
+                      << heuristic.improved << " incumbents, " << heuristic.seconds*1000 << " ms" << std::endl;
+    if(result.x.empty())
+    {
+        if(result.status == MipStatus::UNBOUNDED)
+            std::cout << "Relaxation is unbounded!" << std::endl;
+        std::cout << "There is not solution!" << std::endl;
+        return 0;
+    }
+    std::cout << "Solution: " << Matrix(result.x);
+    if(result.status == MipStatus::OPTIMAL)
+        std::cout << "Optimal value: " << result.objective << std::endl;
+    else
+        std::cout << "Best value (" << to_string(result.status) << "): " << result.objective << std::endl;
+    std::cout << "Bound: " << result.bound << ", gap: " << 100*result.gap << "%" << std::endl;
+
+    return 0;
+}
\ No newline at end of file
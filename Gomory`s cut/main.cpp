@@ -1,87 +1,140 @@
-#include <iostream>
-#include <vector>
-#include <string>
-#include "simplex.hpp"
+#include "../lib/heuristics.hpp"
 
-#define UNUSED_VAR(X) ((void)X)
+// maximum number of rounds (every round adds cuts and solves system again)
+#define MAX_ROUNDS 100
 
-inline double phi(double value)
-{
-    return value - ((int)value);
-}
+// cut that is not tight (slack > EPS) in CUT_MAX_AGE rounds in a row leaves system for pool,
+// cut of pool that x doesn't violate in CUT_MAX_AGE rounds in a row is dropped
+#define CUT_MAX_AGE 3
 
+// lexicographic mode: Gomory's cut of objective row is used only if its norm is at most
+// OBJECTIVE_CUT_MAX_NORM*||c||, otherwise objective cut c*x >= ceil(F) is used
+#define OBJECTIVE_CUT_MAX_NORM 3
+
+// Problem: (min) c*x, A(i)*x relsign(i) b(i), x >= 0 and integer
+// Rows of problem (with active cuts) are kept only to write cuts in original variables, LP relaxation
+// is kept in Solver: cuts are added with add_rows and every round continues from last optimal base
+// Cut pool: active cuts are rows M, M+1, ... of system, cuts that were not tight for CUT_MAX_AGE
+// rounds leave system (remove_rows keeps optimal base) and wait in pool until x violates them again
 class SimplexProblemDefinition {
 private:
-    unsigned m_variables;
-    unsigned m_constraints;
-
     std::vector<std::vector<double> > m_A;
     std::vector<double> m_b;
-    std::vector<double> m_c;
     std::vector<char> m_relsigns;
+    unsigned m_n, m_rows;
+    std::vector<Cut> m_active, m_pool;
 
 public:
-    SimplexProblemDefinition(
-        const std::vector<std::vector<double> >& A,
-        const std::vector<double>& b,
-        const std::vector<double>& c,
-        const std::vector<char>& relsigns)
-        : m_A(A), m_b(b), m_c(c), m_relsigns(relsigns)
+    SimplexProblemDefinition(const LPModel& model)
+        : m_A(model.A.to_dense().to_cpp_matrix()), m_b(model.rhs), m_relsigns(model.sense),
+          m_n(model.cols()), m_rows(model.rows())
+    {
+    }
+
+    unsigned variables() const
     {
-        m_variables = A.at(0).size();
-        m_constraints = A.size();
+        return m_n;
     }
 
-    SimplexProblemDefinition(const Matrix& A, const Matrix& b, const Matrix& c, double F)
-        : m_A(A.to_cpp_matrix()), m_b(b.to_cpp_matrix().at(0)), m_c(c.to_cpp_matrix().at(0))
+    unsigned constraints() const
     {
-        m_variables   = A.width();
-        m_constraints = A.height();
-        m_relsigns.resize(m_constraints, '=');
-
-        m_b.push_back(phi(F));
-        for(unsigned i=0; i<m_constraints; i++)
-            m_A.at(i).push_back(0.0);
-        m_c.push_back(0.0);
-        m_variables++;
-        m_constraints++;
-        std::vector<double> new_constraint;
-        for(unsigned i=0; i<m_variables-1; i++)
-            new_constraint.push_back(-phi(c.at(0, i)));
-        new_constraint.push_back(1.0);
-        m_A.push_back(new_constraint);
-        m_relsigns.push_back('=');
+        return m_A.size();
     }
 
-    std::string format() const
+    // Gomory's cut from row of optimal tableau (lib/cuts.hpp), rows of problem include active cuts
+    bool gomory_cut(const Matrix& row, double value, const std::vector<unsigned>& P, Cut& cut) const
     {
-        std::string out = "";
-        out += std::to_string(m_variables) + " " + std::to_string(m_constraints) + "\n";
-        for(unsigned i=0; i<m_variables; i++)
-            out += std::to_string(m_c.at(i)) + " ";
-        out += "\n";
-        for(unsigned i=0; i<m_constraints; i++)
+        return ::gomory_cut(row, value, P, m_A, m_b, m_relsigns, cut);
+    }
+
+    // Active cuts that are not tight get older (tight cuts get age 0), cuts with age CUT_MAX_AGE
+    // leave system and go to pool (their logical variables are in base, so optimal base is kept)
+    // Cuts of pool that x doesn't violate get older and are dropped at age CUT_MAX_AGE
+    // Returns number of removed cuts
+    unsigned age_cuts(const std::vector<double>& x, Solver& solver)
+    {
+        for(unsigned k=m_pool.size(); k-->0;)
         {
-            for(unsigned j=0; j<m_variables; j++)
-                out += std::to_string(m_A.at(i).at(j)) + " ";
-            out += std::string() + m_relsigns.at(i) + " ";
-            out += std::to_string(m_b.at(i)) + "\n";
+            auto& cut = m_pool.at(k);
+            cut.age = (efficacy(cut, x) > EPS) ? 0 : cut.age + 1;
+            if(cut.age >= CUT_MAX_AGE)
+                m_pool.erase(m_pool.begin() + k);
         }
-        return out;
 
+        std::vector<unsigned> rows;
+        for(unsigned k=m_active.size(); k-->0;)
+        {
+            auto& cut = m_active.at(k);
+            cut.age = (efficacy(cut, x) < -EPS) ? cut.age + 1 : 0;
+            if(cut.age < CUT_MAX_AGE)
+                continue;
+            rows.push_back(m_rows + k);
+            m_A.erase(m_A.begin() + m_rows + k);
+            m_b.erase(m_b.begin() + m_rows + k);
+            m_relsigns.erase(m_relsigns.begin() + m_rows + k);
+            cut.age = 0;
+            m_pool.push_back(cut);
+            m_active.erase(m_active.begin() + k);
+        }
+        solver.remove_rows(rows);
+        return rows.size();
     }
 
-    bool is_invalid() const
+    // Candidates (new cuts and cuts of pool that x violates) are chosen by select_cuts (lib/cuts.hpp),
+    // at most CUTS_PER_ROUND cuts are added to solver, rejected candidates go to pool
+    // first_required ~ first candidate is added even if select_cuts rejects it (cut of lexicographically
+    // first fractional component of (F, x), Gomory's finite convergence)
+    // Returns number of added cuts
+    unsigned add_cuts(std::vector<Cut> candidates, const std::vector<double>& x, Solver& solver, bool first_required)
     {
-        for(unsigned i=0; i<m_variables-1; i++)
-            if(std::fabs(m_A.back().at(i)) > EPS)
-                return false;
-        return true;
+        unsigned new_cuts = candidates.size();
+        for(unsigned k=m_pool.size(); k-->0;)
+            if(efficacy(m_pool.at(k), x) > EPS)
+            {
+                candidates.push_back(m_pool.at(k));
+                m_pool.erase(m_pool.begin() + k);
+            }
+        std::vector<unsigned> rejected;
+        auto chosen = select_cuts(candidates, x, m_active, CUTS_PER_ROUND, &rejected);
+        auto first = std::find(rejected.begin(), rejected.end(), 0u);
+        if(first_required && new_cuts > 0 && first != rejected.end())
+        {
+            rejected.erase(first);
+            chosen.insert(chosen.begin(), 0);
+        }
+        for(auto k: rejected)
+            m_pool.push_back(candidates.at(k));
+
+        std::vector<std::vector<double> > rows;
+        std::vector<char> senses(chosen.size(), '>');
+        std::vector<double> rhs;
+        for(auto k: chosen)
+        {
+            const auto& cut = candidates.at(k);
+            std::cout << "Cut (>= " << cut.rhs << ", efficacy " << efficacy(cut, x) << "): " << Matrix(cut.a);
+            m_A.push_back(cut.a);
+            m_b.push_back(cut.rhs);
+            m_relsigns.push_back('>');
+            m_active.push_back(cut);
+            rows.push_back(cut.a);
+            rhs.push_back(cut.rhs);
+        }
+        solver.add_rows(rows, senses, rhs);
+        return chosen.size();
     }
 
+    unsigned active() const
+    {
+        return m_active.size();
+    }
+
+    unsigned pool() const
+    {
+        return m_pool.size();
+    }
 };
 
-bool is_x_integer(std::vector<double> x)
+bool is_x_integer(const std::vector<double>& x)
 {
     for(unsigned i=0; i<x.size(); i++)
         if(phi(x.at(i)) >= EPS)
@@ -94,68 +147,180 @@ bool is_x_integer(std::vector<double> x)
 
 int main(int argc, char** argv)
 {
-    UNUSED_VAR(argc);
-    const char* path = argv[1];
+    std::cout << std::fixed;
+    std::cout << std::setprecision(2);
 
-    std::ifstream input(path);
-    if(input.fail())
+    // [--lex] [file]
+    // --lex ~ lexicographic dual simplex and cut of first fractional component of (F, x) in every round
+    const char* path = "input.txt";
+    bool lexicographic = false;
+    for(int i=1; i<argc; i++)
     {
-        std::cout << "Failed to open \"input.txt\"!" << std::endl;
-        return 1;
+        if(std::string(argv[i]) == "--lex")
+            lexicographic = true;
+        else
+            path = argv[i];
     }
 
     // *TASK INPUT*
+    LPModel model;
+    ReadStats stats;
+    try
+    {
+        model = read_model(path, false, stats);
+    }
+    catch(const std::runtime_error& e)
+    {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    for(unsigned j=0; j<model.cols(); j++)
+        if(model.lower.at(j) != 0.0 || !std::isinf(model.upper.at(j)))
+        {
+            std::cout << "Gomory's cut solves only systems with x >= 0 (bounds are not supported)!" << std::endl;
+            return 1;
+        }
 
     // n - number of vars
     // m - number of inequalities
-    unsigned n, m;
-    input >> n >> m;
-
-    std::vector<double> c(n);
-    std::vector<std::vector<double> > A(m, std::vector<double> (n));
-    std::vector<double> b(m);
-    std::vector<char> relsigns(m);
+    SimplexProblemDefinition problem(model);
 
-    for(unsigned i=0; i<n; i++)
-        input >> c.at(i);
+    // Every round: solve relaxation (without scaling, so tableau has original values) and
+    // make Gomory's cut from every row whose base variable is structural and has fractional value,
+    // best of them (add_cuts) are added to system together with violated cuts of pool
+    // Round 0 solves relaxation from scratch, next rounds continue with dual simplex from
+    // optimal base of previous round (only cut rows are violated), so round costs only its pivots
+    // Lexicographic mode (Solver::set_lexicographic): every optimal base is lexicographically optimal,
+    // dual simplex keeps it so and cut of first fractional component of (F, x) is always added,
+    // so (F, x) grows lexicographically every round and loop can't stall on degenerate vertex
+    Solver solver;
+    solver.load(model);
+    solver.set_scaling(false);
+    solver.set_lexicographic(lexicographic);
+    solver.set_log(&std::cout);
+    unsigned long pivots = 0;
 
-    std::string relsign;
-    for(unsigned i=0; i<m; i++)
+    // Incumbent (lib/heuristics.hpp): simple rounding of x in every round, feasibility pump in
+    // round 0 (all variables are integer), rounds stop when incumbent reaches bound of relaxation
+    LPModel integer_model = model;
+    integer_model.is_integer.assign(model.cols(), true);
+    std::vector<double> incumbent;
+    double sign = model.maximize ? -1.0 : 1.0;
+    bool integer_costs = std::all_of(model.c.begin(), model.c.end(), [](double value) { return phi(value) == 0.0; });
+    for(unsigned round=0; round<=MAX_ROUNDS; round++)
     {
-        for(unsigned j=0; j<n; j++)
-            input >> A.at(i).at(j);
-        input >> relsign;
-        relsigns.at(i) = relsign.at(0);
-        input >> b.at(i);
-    }
-
-    SimplexProblemDefinition initial_problem(A, b, c, relsigns);
-
-    std::cout << initial_problem.format() << std::endl;
-    auto[result_F, result_x, result_A, result_b, result_c] = simplex(initial_problem.format());
-    std::cout << "Optimal value: " << result_F << std::endl;
-    std::cout << "Variable results: " << result_x << std::endl;
-    std::cout << "A: \n" << result_A << std::endl;
-    std::cout << "b: " << result_b << std::endl;
-    std::cout << "c: " << result_c << std::endl;
+        std::cout << BAR << std::endl;
+        std::cout << "ROUND " << round << ":" << std::endl;
 
-    while(!is_x_integer(result_x.to_cpp_matrix().at(0)))
-    {
-        SimplexProblemDefinition problem(result_A, result_b, result_c, result_F);
-        std::cout << problem.format() << std::endl;
-        if(problem.is_invalid())
+        if(solver.solve() != SolverStatus::OPTIMAL)
         {
             std::cout << "There is not solution!" << std::endl;
             return 0;
         }
-        
-        auto result = simplex(problem.format());
-        result_F = std::get<0>(result);
-        result_x = std::get<1>(result);
-        result_A = std::get<2>(result);
-        result_b = std::get<3>(result);
-        result_c = std::get<4>(result);
+
+        auto x = solver.x();
+        pivots += solver.counters().pivots;
+        std::cout << "Optimal value: " << solver.objective() << std::endl;
+        std::cout << "Variable results: " << Matrix(x);
+        std::cout << "Pivots: " << solver.counters().pivots << ", factorizations: " << solver.counters().factorizations << std::endl;
+        if(is_x_integer(x))
+        {
+            std::cout << "Rounds to integrality: " << round << " (" << (lexicographic ? "lexicographic" : "standard")
+                      << " dual simplex, pivots of all rounds: " << pivots << ")" << std::endl;
+            return 0;
+        }
+
+        std::vector<double> solution;
+        bool found = simple_rounding(integer_model, x, solution);
+        if(!found && round == 0)
+        {
+            Solver pump = solver;
+            pump.set_log(nullptr);
+            found = feasibility_pump(integer_model, pump, integer_model.lower, integer_model.upper, solution);
+        }
+        if(found && (incumbent.empty() || sign*objective_value(model, solution) < sign*objective_value(model, incumbent)))
+        {
+            incumbent = solution;
+            std::cout << "Incumbent: " << objective_value(model, incumbent) << " " << Matrix(incumbent);
+        }
+        if(!incumbent.empty())
+        {
+            double F = objective_value(model, incumbent), gap = sign*(F - solver.objective())/std::max(1.0, std::fabs(F));
+            std::cout << "Gap: " << 100*gap << "%" << std::endl;
+            if(gap <= EPS)
+            {
+                std::cout << "Incumbent reaches bound of relaxation after " << round << " rounds (pivots of all rounds: "
+                          << pivots << "):" << std::endl;
+                std::cout << "Optimal value: " << F << std::endl;
+                std::cout << "Variable results: " << Matrix(incumbent);
+                return 0;
+            }
+        }
+        if(round == MAX_ROUNDS)
+            break;
+
+        unsigned removed = problem.age_cuts(x, solver);
+        const auto& P = solver.basis();
+        std::vector<unsigned> rows;
+        for(unsigned k=0; k<P.size(); k++)
+            if(P.at(k) < problem.variables() && phi(x.at(P.at(k))) > 0.0)
+                rows.push_back(k);
+        // lexicographic mode: first candidate is cut of first fractional component of (F, x):
+        // objective row if F = c*x is fractional (only for integer c, otherwise F of integer x doesn't
+        // have to be integer), otherwise row of lexicographically first fractional variable
+        if(lexicographic)
+            std::sort(rows.begin(), rows.end(), [&](unsigned first, unsigned second) { return P.at(first) < P.at(second); });
+
+        // Objective cut (integer c, F = c*x of system is integer for integer x): Gomory's cut of objective
+        // row of tableau, but if its coefficients in original variables are much larger than c (slack
+        // variables of many earlier cuts, rounding errors of tableau) then cut of objective row in
+        // original variables (F = c*x, integer coefficients) is used: c*x >= ceil(F)
+        std::vector<Cut> candidates;
+        if(lexicographic && integer_costs)
+        {
+            Cut cut;
+            cut.a.assign(model.cols(), 0.0);
+            cut.age = 0;
+            double F = 0.0;
+            for(unsigned j=0; j<model.cols(); j++)
+            {
+                cut.a.at(j) = sign*model.c.at(j);
+                F += cut.a.at(j)*x.at(j);
+            }
+            cut.rhs = std::ceil(F);
+            if(phi(F) > 0.0)
+            {
+                Cut tableau_cut;
+                bool made = problem.gomory_cut(solver.objective_row(), F, P, tableau_cut);
+                if(made && norm(tableau_cut.a) <= OBJECTIVE_CUT_MAX_NORM*norm(cut.a))
+                    cut = tableau_cut;
+                std::cout << "Objective value is fractional => first cut is made from objective row" << std::endl;
+                candidates.push_back(cut);
+            }
+        }
+        auto tableau = solver.tableau_rows(rows);
+        for(unsigned k=0; k<rows.size(); k++)
+        {
+            Cut cut;
+            if(!problem.gomory_cut(tableau.at(k), x.at(P.at(rows.at(k))), P, cut))
+            {
+                std::cout << "There is not solution!" << std::endl;
+                return 0;
+            }
+            candidates.push_back(cut);
+        }
+        unsigned added = problem.add_cuts(candidates, x, solver, lexicographic);
+        std::cout << "Cuts: " << candidates.size() << " candidates, " << added << " added, " << removed
+                  << " removed (active: " << problem.active() << ", pool: " << problem.pool() << ")" << std::endl;
+        if(added == 0)
+        {
+            std::cout << "All cuts are already in system (x is cut off only by rounding errors)!" << std::endl;
+            break;
+        }
     }
+    std::cout << "Integer solution is not found (pivots of all rounds: " << pivots << ")!" << std::endl;
+    if(!incumbent.empty())
+        std::cout << "Best integer solution (heuristics): " << objective_value(model, incumbent) << " " << Matrix(incumbent);
 
     return 0;
 }
\ No newline at end of file
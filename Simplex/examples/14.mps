@@ -0,0 +1,20 @@
+* example 13 in fixed MPS format
+NAME          EXAMPLE13
+ROWS
+ N  COST
+ L  LIM1
+ L  LIM2
+COLUMNS
+    X0        COST      -3             LIM1      1
+    X0        LIM2      2
+    X1        COST      -2             LIM1      1
+    X2        COST      -4             LIM1      2
+    X2        LIM2      1
+RHS
+    RHS       LIM1      10             LIM2      8
+BOUNDS
+ UP BND       X0        3
+ LO BND       X1        1
+ UP BND       X1        4
+ UP BND       X2        2.5
+ENDATA
@@ -1,416 +1,310 @@
-#include <iostream>
-#include <fstream>
-#include <utility>
-#include <climits>
-#include <cfloat>
-#include <cmath>
-#include <ctime>
-#include <iomanip>
-#include "../lib/matrix.hpp"
-
-#define STOP ((unsigned)-1)
-#define INF DBL_MAX
-
-#define BAR "------------------------------------------------------"
-
-// precision: EPS
-#define EPS 0.0001
-
-template<typename T>
-void vector_print(const std::vector<T>& v)
+#include "../lib/lp_solver.hpp"
+#include <filesystem>
+#include <mutex>
+
+// Options of solver (same for one file and for batch mode)
+struct Options {
+    std::string method = "simplex";
+    bool scaling = true, fixed_mps = false, crossover = false, perturbation = true;
+    unsigned threads = 0, seed = 1;
+};
+
+void configure(Solver& solver, const Options& options)
 {
-    for(auto e: v)
-        std::cout << e << " ";
-    std::cout << std::endl;
+    solver.set_scaling(options.scaling);
+    solver.set_crossover(options.crossover);
+    solver.set_threads(options.threads);
+    if(options.method == "dual")
+        solver.set_method(SolverMethod::DUAL);
+    else if(options.method == "two-phase")
+        solver.set_method(SolverMethod::TWO_PHASE);
+    else if(options.method == "composite")
+        solver.set_method(SolverMethod::COMPOSITE);
+    else if(options.method == "barrier")
+        solver.set_method(SolverMethod::BARRIER);
+    else if(options.method == "concurrent")
+        solver.set_method(SolverMethod::CONCURRENT);
 }
 
-bool is_not_canonical(const Matrix& A, const Matrix& b)
+// Files of batch: all files of directory (sorted by name) or files listed in manifest
+// (one path per line, relative paths are relative to directory of manifest, empty lines
+// and lines starting with '#' are skipped)
+std::vector<std::string> batch_paths(const std::string& path)
 {
-    // Checking if b > 0
-    for(unsigned i=0; i<b.width(); i++)
-        if(b.at(0, i) < 0)
-            return true;
-
-    // Checking if b has canonical base
-    // 1 0 ...   0 ...
-    // 0 1 0 ... 0 ...
-    // ...         ...
-    // 0 ...     1 ...
-
-    // fabs(A.at(i, j) - 1) > EPS instead of A.at(i, j) != 1 because of precision
-    // A.at(i, j) might be 0.99999999
-
-    for(unsigned i=0; i<A.height(); i++)
-        for(unsigned j=0; j<A.height(); j++)
-            if(i == j && std::fabs(A.at(i, j)-1) > EPS)
-                return true;
-            else if(i != j && std::fabs(A.at(i, j)) > EPS)
-                return true;
+    std::vector<std::string> paths;
+    if(std::filesystem::is_directory(path))
+    {
+        for(const auto& entry: std::filesystem::directory_iterator(path))
+            if(entry.is_regular_file())
+                paths.push_back(entry.path().string());
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
 
-    return false;
+    std::ifstream file(path);
+    if(!file)
+        throw std::runtime_error("Failed to open \"" + path + "\"!");
+    auto dir = std::filesystem::path(path).parent_path();
+    std::string line;
+    while(std::getline(file, line))
+    {
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if(line.empty() || line.at(0) == '#')
+            continue;
+        std::filesystem::path entry(line);
+        paths.push_back(entry.is_relative() ? (dir / entry).string() : line);
+    }
+    return paths;
 }
 
-std::tuple<std::vector<unsigned>, std::vector<unsigned>, double> set_unit_matrix(Matrix& A, Matrix& b, Matrix& c)
+// Batch mode: files are solved by pool of jobs threads, every thread takes next file,
+// reads it, solves it and drops model, so at most jobs models are in memory at once
+// Solvers write nothing (their output is thread-local) and result lines are written in
+// order of files as soon as all earlier files are solved:
+// path: status[, optimal value F], time ms
+// Values are the same as values of one file runs (same options, same precision)
+void solve_batch(const std::vector<std::string>& paths, const Options& options, unsigned jobs)
 {
-    srand(time(NULL));
-
-    auto n = A.height();
-    auto m = A.width();
-    double Fo = 0.0;
-    // i ~ column, j ~ row
-    while(is_not_canonical(A, b)) 
+    std::vector<std::string> lines(paths.size());
+    std::vector<bool> done(paths.size(), false);
+    unsigned next_print = 0, optimal = 0;
+    std::atomic<unsigned> next(0);
+    std::mutex lock;
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]()
     {
-        for(unsigned i=0; i<n; i++)
+        for(unsigned k = next++; k < paths.size(); k = next++)
         {
-            if(A.at(i, i)*b.at(0, i) < 0)
+            std::ostringstream line;
+            line << std::fixed << std::setprecision(2);
+            line << paths.at(k) << ": ";
+            bool solved = false;
+            try
             {
-                // If b(i) is negative then we have to pick different columns for base
-                // Finding all potential base columns:
-                std::vector<unsigned> potential_base_columns;
-                for(unsigned j=i+1; j<m; j++)
-                    if(A.at(i, j)*b.at(0, i) > 0)
-                    {
-                        potential_base_columns.push_back(j);
-                    }
-
-                // Picking random column and replacing it with current one in base:
-                unsigned new_column_index = rand() % potential_base_columns.size();
-                unsigned new_column = potential_base_columns.at(new_column_index);
-                swap_columns(A, i, new_column);
-                swap_columns(c, i, new_column);
+                ReadStats stats;
+                Solver solver;
+                solver.load(read_model(paths.at(k), options.fixed_mps, stats));
+                configure(solver, options);
+                auto begin = std::chrono::steady_clock::now();
+                auto status = solver.solve();
+                std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - begin;
+                line << to_string(status);
+                if(status == SolverStatus::OPTIMAL)
+                    line << ", optimal value " << solver.objective();
+                line << ", " << seconds.count()*1000 << " ms";
+                solved = status == SolverStatus::OPTIMAL;
             }
-            // "clearing" i-th column
-            // "clearing" - Transformation with result of i-th column having
-            // 0s above and below i-th row and 1 for i-th row
-            for(unsigned j=0; j<n; j++)
+            catch(const std::exception& e)
             {
-                if(i == j)
-                    continue;
-                double coef = A.at(j, i)/A.at(i, i);
-                for(unsigned k=0; k<m; k++)
-                    A.at(j, k) -= coef*A.at(i, k);
-                b.at(0, j) -= coef*b.at(0, i);
+                line << "error, " << e.what();
             }
-            double coef = A.at(i, i);
-            for(unsigned k=0; k<m; k++)
-                A.at(i, k) /= coef;
-            b.at(0, i) /= coef;
-
-            coef = c.at(0, i)/A.at(i, i);
-            for(unsigned k=0; k<m; k++)
-                c.at(0, k) -= coef*A.at(i, k);
 
-            Fo -= coef*b.at(0, i);
+            std::lock_guard<std::mutex> guard(lock);
+            lines.at(k) = line.str();
+            done.at(k) = true;
+            optimal += solved;
+            for(; next_print < paths.size() && done.at(next_print); next_print++)
+            {
+                std::cout << lines.at(next_print) << std::endl;
+                lines.at(next_print).clear();
+            }
         }
-    }
-
-    std::vector<unsigned> P, Q;
-    for(unsigned i=0; i<m; i++)
-        if(i<n)
-            P.push_back(i);
-        else
-            Q.push_back(i);
-    return std::make_tuple(P, Q, Fo);
-}
-
-Matrix get_B(const Matrix& A, const std::vector<unsigned>& P)
-{
-    Matrix B = Matrix(A.height(), 0);
-    for(auto p: P)
-        append(B, A.col(p));
+    };
 
-    return B;
-}
-
-Matrix get_Cb(const Matrix& c, const std::vector<unsigned>& P)
-{
-    Matrix Cb = Matrix(1, P.size());
-    for(unsigned i=0; i<P.size(); i++)
-        Cb.at(0, i) = c.at(0, P.at(i));
-
-    return Cb;
-}
-
-Matrix get_Kq(const Matrix& A, const std::vector<unsigned>& Q)
-{
-    Matrix Kq = Matrix(A.height(), 0);
-    for(auto q: Q)
-        append(Kq, A.col(q));
+    std::vector<std::thread> threads;
+    for(unsigned t=0; t<jobs; t++)
+        threads.emplace_back(worker);
+    for(auto& thread: threads)
+        thread.join();
 
-    return Kq;
-}
-
-Matrix get_Cq(const Matrix& c, const std::vector<unsigned>& Q)
-{
-    Matrix Cq = Matrix(1, Q.size());
-    for(unsigned i=0; i<Q.size(); i++)
-        Cq.at(0, i) = c.at(0, Q.at(i));
-
-    return Cq;
-}
-
-unsigned get_first_negative(const Matrix& r)
-{
-    for(unsigned i=0; i<r.width(); i++)
-        if(r.at(0, i) < 0)
-            return i;
-    return STOP;
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    std::cout << BAR << std::endl;
+    std::cout << "Solved " << paths.size() << " files (" << optimal << " optimal) with " << jobs
+              << " threads in " << seconds.count() << " s" << std::endl;
 }
 
-// Starting with x: if i in P then we set next unused value of b for x(i) else x(i) = 0
-Matrix get_x(const Matrix& b, const std::vector<unsigned>& P, unsigned size)
+int main(int argc, char** argv)
 {
-    unsigned j = 0;
-    Matrix x(1, size, 0);
-    for(auto p: P)
-        x.at(0, p) = b.at(0, j++);
-
-    return x;
-}
+    std::cout << std::fixed;
+    std::cout << std::setprecision(2);
 
-std::pair<double, unsigned> get_t_opt(const Matrix& x, const Matrix& y, const std::vector<unsigned>& P)
-{
-    double t = INF;
-    unsigned t_index;
-    for(unsigned i=0; i<y.width(); i++)
+    // *INPUT FILE* and options:
+    // --no-scaling       ~ system is solved without scaling
+    // --save-basis FILE  ~ optimal base is saved to FILE
+    // --load-basis FILE  ~ simplex starts from base saved in FILE (warm start)
+    // --fixed-mps        ~ .mps file is read in fixed format (default is free format)
+    // --method M         ~ simplex (default), dual (dual simplex from slack base), two-phase (phase one with
+    //                      artificial variables), composite (artificial variables and cost together),
+    //                      barrier (interior point method)
+    //                      or concurrent (primal, dual and barrier in parallel threads, first optimal wins)
+    // --crossover        ~ barrier solution is moved to optimal base with simplex
+    // --threads T        ~ number of threads for barrier factorization (default: all cores, 1 in batch mode)
+    // --batch DIR|FILE   ~ all files of directory or files listed in manifest are solved, one line per file
+    // --jobs J           ~ number of files solved at once in batch mode (default: all cores)
+    // --no-perturbation  ~ b is never perturbed (anti-degeneracy of residual simplex)
+    // --seed S           ~ seed of perturbation (default 1)
+    // --stats            ~ counters and times of parts of iterations are written after solve
+    // --stats-json FILE  ~ same statistics are saved to FILE as JSON
+    std::string path = "input.txt";
+    std::string save_path, load_path, batch_path, stats_path;
+    Options options;
+    bool threads_set = false, show_stats = false;
+    unsigned jobs = 0;
+    for(int i=1; i<argc; i++)
     {
-        double val = x.at(0, P.at(i))/y.at(0, i);
-        if(y.at(0, i) > 0 && val < t)
+        std::string arg(argv[i]);
+        if(arg == "--no-scaling")
+            options.scaling = false;
+        else if(arg == "--save-basis" && i+1 < argc)
+            save_path = argv[++i];
+        else if(arg == "--load-basis" && i+1 < argc)
+            load_path = argv[++i];
+        else if(arg == "--fixed-mps")
+            options.fixed_mps = true;
+        else if(arg == "--method" && i+1 < argc)
+            options.method = argv[++i];
+        else if(arg == "--crossover")
+            options.crossover = true;
+        else if(arg == "--threads" && i+1 < argc)
         {
-            t = val;
-            t_index = P.at(i);
+            options.threads = std::stoi(argv[++i]);
+            threads_set = true;
         }
+        else if(arg == "--batch" && i+1 < argc)
+            batch_path = argv[++i];
+        else if(arg == "--jobs" && i+1 < argc)
+            jobs = std::stoi(argv[++i]);
+        else if(arg == "--no-perturbation")
+            options.perturbation = false;
+        else if(arg == "--seed" && i+1 < argc)
+            options.seed = std::stoi(argv[++i]);
+        else if(arg == "--stats")
+            show_stats = true;
+        else if(arg == "--stats-json" && i+1 < argc)
+            stats_path = argv[++i];
+        else
+            path = argv[i];
     }
-
-    return std::make_pair(t, t_index);
-}
-
-void update_x(Matrix& x, const Matrix& y, unsigned l, const std::vector<unsigned>& P, double t_opt)
-{
-    for(unsigned i=0; i<y.width(); i++)
+    const auto& method = options.method;
+    if(method != "simplex" && method != "dual" && method != "two-phase" && method != "composite" && method != "barrier" && method != "concurrent")
     {
-        unsigned index = P.at(i);
-        x.at(0, index) -= y.at(0, i)*t_opt;
+        std::cout << "Unknown method \"" << method << "\"!" << std::endl;
+        return 1;
     }
-    x.at(0, l) = t_opt;
-}
 
-void update_P_Q(std::vector<unsigned>& P, std::vector<unsigned>& Q, unsigned t_index, unsigned l)
-{
-    for(auto& p: P)
-        if(p == t_index)
-        {
-            p = l;
-            break;
-        }
-    for(auto& q: Q)
-        if(q == l)
-        {
-            q = t_index;
-            break;
-        }
-}
+    // perturbation is same for all solvers (and threads)
+    set_perturbation(options.perturbation, options.seed);
 
-bool has_all_negative(const Matrix& y)
-{
-    for(unsigned i=0; i<y.width(); i++)
-        if(y.at(0, i) > 0)
-            return false;
-    return true;
-}
-
-std::pair<double, Matrix> residual_simplex(Matrix& A, Matrix& b, Matrix& c,
-                                           std::vector<unsigned>& P, std::vector<unsigned>& Q, double Fo)
-{
-
-    // Preprocess: Calculating x:
-    auto x = get_x(b, P, c.width());
-    std::cout << "Starting x value: " << x << std::endl;
-    unsigned iteration = 0;
-    while(true)
+    // *BATCH MODE*
+    // Every thread solves one file at a time, so barrier uses one thread per file unless --threads is given
+    if(!batch_path.empty())
     {
-        std::cout << BAR << std::endl;
-        std::cout << "ITERATION " << iteration++ << ":" << std::endl;
-        // Cb ~ contains values from c where c(i) is in Cb if i is in P
-        // P = [1, 3, 4], C = [c1, c2, ... cN] => Cb = [c1, c3, c4]
-
-        // Step1: Solve u*B = Cb <=> u = Cb*B' (B' is inverse matrix of B)
-        // This is equivalent to u*K(i) = c(i) for i in P which is what we need to find optimal value
-
-        auto B = get_B(A, P);
-        auto Cb = get_Cb(c, P);
-        auto u = Cb*B.inv();
-        std::cout << "Step1: Solving system(1): uB = Cb" << std::endl;
-        std::cout << "B:" << std::endl;
-        std::cout << B << std::endl;
-        std::cout << "Cb: " << Cb << std::endl;
-        std::cout << "Result of u(1):" << u << std::endl;
-
-        // Step2: Calculating r
-        // r(j) = c(j) - u*K(j)
-        // if (r >= 0) then we found our optimal value
-        // This is equivalent to (l_index == STOP) which we get from get_first_negative(r)   
-        auto Kq = get_Kq(A, Q);
-        auto Cq = get_Cq(c, Q);
-        auto r = Cq - u*Kq;
-        // K := Kq in output
-        // C := Cq in output
-        std::cout << "Step2: Calculating r (r := C - uK):" << std::endl;
-        std::cout << "C: " << Cq << std::endl;
-        std::cout << "K: " << std::endl;
-        std::cout << Kq << std::endl; 
-        std::cout << "Result(r): " << r << std::endl;
-
-        // If r > 0 then optimal value is found
-        auto l_index = get_first_negative(r);
-        if(l_index == STOP)
+        std::vector<std::string> paths;
+        try
         {
-            std::cout << "(r > 0) is true => optimal value is found!" << std::endl;
-            break;
+            paths = batch_paths(batch_path);
         }
-        auto l = Q.at(l_index);
-        std::cout << "Bland's rule: first negative r(i) is r" << l_index << "!" << std::endl;
-
-        // Step3: Solve B*y = Kl <=> y = B'Kl <=> y = B/Kl where r(l) < 0
-        auto Kl = A.col(l);
-        auto y = (B/Kl).transpose();
-        std::cout << "Step3: Solving system(2): By = K" << l_index << std::endl;
-        std::cout << "B:" << std::endl;
-        std::cout << B << std::endl;
-        std::cout << "K" << l << ": " << std::endl << Kl << std::endl;
-        std::cout << "Result of y(2):" << y << std::endl;
-
-        // Step4: If y has all negative values, then there is no optimum value (its not bounded)
-        // Otherwise we get t_opt := min{x(i)/y(i) | y(i) > 0}
-        std::cout << "Step4: check if y <= 0:" << std::endl;
-        if(has_all_negative(y))
+        catch(const std::exception& e)
         {
-            std::cout << "Function does not reach optimal value because (y <= 0) is true!" << std::endl;
-            return std::make_pair(0, Matrix());
+            std::cout << e.what() << std::endl;
+            return 1;
         }
-        std::cout << "(y <= 0) is not true!" << std::endl;
-        std::cout << "Finding optimal t:" << std::endl;
-        auto[t_opt, t_index] = get_t_opt(x, y, P);
-        std::cout << "Optimal t: " << t_opt << std::endl;
-        std::cout << "Column " << t_index << " leaves base (P)" << std::endl;
-
+        if(jobs == 0)
+            jobs = std::max(1u, std::thread::hardware_concurrency());
+        jobs = std::max(1u, std::min<unsigned>(jobs, paths.size()));
+        if(!threads_set)
+            options.threads = 1;
+        solve_batch(paths, options, jobs);
+        return 0;
+    }
 
-        // Step5: With t_opt we can update our x:
-        // x(i) = x_old(i) - t_opt*y(i), for i in P
-        // x(i) = t_opt, for i == l
-        // x(i) = 0, otherwise
-        // We replace t_index in P with l and l in Q with t_index (new base P)
-        std::cout << "Step5: updating x:" << std::endl;
-        std::cout << "Old x: " << x;
-        update_x(x, y, l, P, t_opt);
-        update_P_Q(P, Q, t_index, l);
-        std::cout << "New x: " << x << std::endl;
+    // *TASK INPUT*
+    // Model is read from dense text format, MPS (.mps) or CPLEX LP (.lp) file (see README.md)
+    LPModel model;
+    ReadStats stats;
+    try
+    {
+        model = read_model(path, options.fixed_mps, stats);
     }
+    catch(const std::runtime_error& e)
+    {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    print_read_stats(std::cout, model, stats);
     std::cout << BAR << std::endl;
 
-    // c*(x.transpose()) is matrix with dimension 1x1
-    double F = -Fo + (c*(x.transpose())).at(0, 0);
-    return std::make_pair(F, x);
-}
-
-void show_system(const Matrix& A, const Matrix& b, const Matrix& c)
-{
-    std::cout << "c: " << c << std::endl;
-    std::cout << "A:" << std::endl;
-    std::cout << A << std::endl;
-    std::cout << "b: " << b << std::endl << std::endl;
-}
-
-int main(int argc, char** argv)
-{
-    std::cout << std::fixed;
-    std::cout << std::setprecision(2);
-
-    // *INPUT FILE*
-    const char* path = (argc >= 2) ? argv[1] : "input.txt";
-
-    std::ifstream input(path);
-    if(input.fail())
+    // Solver transforms model to system Ax + s = b, 0 <= x <= u (see lib/lp_solver.hpp),
+    // writes every step to std::cout and gives results for original model
+    Solver solver;
+    try
     {
-        std::cout << "Failed to open \"input.txt\"!" << std::endl;
+        solver.load(model);
+    }
+    catch(const std::invalid_argument& e)
+    {
+        std::cout << e.what() << std::endl;
         return 1;
     }
+    solver.set_log(&std::cout);
+    configure(solver, options);
 
-    // *TASK INPUT*
-
-    // n - number of vars
-    // m - number of inequalities
-    unsigned n, m;
-    input >> n >> m;
-
-    std::vector<double> in_c(n);
-    std::vector<std::vector<double> > in_A(m, std::vector<double> (n));
-    std::vector<double> in_b(m);
-    std::string eq_sign;
-
-    for(unsigned i=0; i<n; i++)
-        input >> in_c.at(i);
-
-    unsigned new_n = n;
-    for(unsigned i=0; i<m; i++)
+    // Warm start: loaded base is used if it is primal or dual feasible, otherwise we start from scratch
+    if(!load_path.empty() && method != "barrier" && method != "concurrent")
     {
-        for(unsigned j=0; j<n; j++)
-            input >> in_A.at(i).at(j);
-        input >> eq_sign;
-        input >> in_b.at(i);
-
-        if(eq_sign == "=")
-            continue;
-        
-        // if sign is > then transform it to <
-        if(eq_sign == ">")
-        {
-            for(unsigned j=0; j<n; j++) 
-                in_A.at(i).at(j) *= -1;
-            in_b.at(i) *= -1;
-        }
-
-        // add new var to convert inequation to equation:
-        // x1 + x2 + x3 ... xN <= c
-        // => x1 + x2 + x3 ... xN + x = c
-        new_n++;
-        for(unsigned j=0; j<m; j++)
-            in_A.at(j).push_back((i==j) ? 1 : 0);
-        in_c.push_back(0);
+        std::vector<bool> at_upper;
+        auto P = load_basis(load_path, solver.height(), solver.width(), at_upper);
+        if(P.empty())
+            std::cout << "Failed to load base from \"" << load_path << "\"!" << std::endl;
+        else
+            solver.set_basis(P, at_upper);
     }
 
-    Matrix c(in_c), A(in_A), b(in_b);
-    std::cout << "Solving system(canonical form): Ax = b" << std::endl;
-    show_system(A, b, c);
-    std::cout << BAR << std::endl;
-
-    // Rezidual Simplex:
-    // P ~ column indexes of base matrix B
-    // Q ~ other column indexes
-    // Fo ~ base value of F where F = Fo + c*x
-    // x ~ solution
-    auto[P, Q, Fo] = set_unit_matrix(A, b, c);
-
-    std::cout << "set_unit_matrix:" << std::endl;
-    show_system(A, b, c);
-
-    std::cout << "Base indexes(P): ";
-    vector_print(P);
-    std::cout << "Nonbase indexes(Q): ";
-    vector_print(Q);
-    
-    std::cout << "Base function value(Fo): " << Fo << std::endl;
-    std::cout << BAR << std::endl;
-
-    std::cout << "Residual simplex: " << std::endl;
-    auto[F, x] = residual_simplex(A, b, c, P, Q, Fo);
+    // Statistics: timers and densities are collected only if statistics are asked for
+    // (time of writing steps to std::cout is in "other" part)
+    bool collect = show_stats || !stats_path.empty();
+    set_stats(collect);
+    auto start = std::chrono::steady_clock::now();
+    auto status = solver.solve();
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    if(collect)
+    {
+        std::cout << BAR << std::endl;
+        print_stats(std::cout, solver.counters(), seconds.count());
+        std::cout << BAR << std::endl;
+    }
+    if(!stats_path.empty())
+    {
+        std::ofstream file(stats_path);
+        write_stats_json(file, solver.counters(), seconds.count());
+        if(!file)
+            std::cout << "Failed to save statistics to \"" << stats_path << "\"!" << std::endl;
+    }
 
-    // if x.height() == 0 and x.width() == 0 then there is no solution (special case value)
-    if(x.height() == 0 && x.width() == 0)
+    // if status is not optimal then there is no solution (solver has written the reason)
+    if(status != SolverStatus::OPTIMAL)
         return 0;
 
-    std::cout << "Solution: " << x;
-    std::cout << "Optimal value: " << F << std::endl;
+    // Solution: structural variables and slack variables of inequalities
+    std::vector<double> solution = solver.x();
+    auto slacks = solver.slacks();
+    for(unsigned i=0; i<model.rows(); i++)
+        if(model.sense.at(i) != '=')
+            solution.push_back(slacks.at(i));
+    std::cout << "Solution: " << Matrix(solution);
+    std::cout << "Optimal value: " << solver.objective() << std::endl;
+
+    if(!save_path.empty())
+    {
+        if(solver.basis().empty())
+            std::cout << "There is no base to save (barrier without crossover)!" << std::endl;
+        else if(save_basis(save_path, solver.basis(), solver.at_upper()))
+            std::cout << "Optimal base is saved to \"" << save_path << "\"" << std::endl;
+        else
+            std::cout << "Failed to save base to \"" << save_path << "\"!" << std::endl;
+    }
 
     return 0;
 }
\ No newline at end of file
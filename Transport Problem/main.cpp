@@ -12,6 +12,7 @@
 #include <cmath>
 #include <cfloat>
 #include <stack>
+#include <chrono>
 #include "lib/graph.hpp"
 
 #define INF std::numeric_limits<double>::infinity()
@@ -99,6 +100,43 @@ struct cell {
 
 bool operator>(const cell& c1, const cell& c2) { return c1.value > c2.value; }
 
+// x(i, j) = min(a(i), b(j)), exhausted row or column is crossed out (only one of them if both are
+// exhausted, so base gets n+m-1 cells and next cell of other one gets x = 0)
+// Last active row or column is never crossed out, otherwise remaining lines would have no cell
+void allocate_cell(unsigned i, unsigned j,
+        std::vector<std::vector<std::pair<double, bool> > >& base_matrix,
+        std::vector<double>& a, std::vector<double>& b,
+        std::vector<bool>& active_rows, std::vector<bool>& active_columns,
+        unsigned& used_rows, unsigned& used_columns)
+{
+    double min_ab = std::min(a.at(i), b.at(j));
+    base_matrix.at(i).at(j) = std::make_pair(min_ab, true);
+    a.at(i) -= min_ab;
+    b.at(j) -= min_ab;
+
+    bool row = std::fabs(a.at(i)) < EPS, column = std::fabs(b.at(j)) < EPS;
+    if(row && column)
+    {
+        auto n = a.size(), m = b.size();
+        if(used_rows+1 == n)
+            row = false;
+        else if(used_columns+1 == m)
+            row = true;
+        else
+            row = used_rows <= used_columns;
+    }
+    if(row)
+    {
+        active_rows.at(i) = false;
+        used_rows++;
+    }
+    else
+    {
+        active_columns.at(j) = false;
+        used_columns++;
+    }
+}
+
 std::vector<std::vector<std::pair<double, bool> > >
     calculate_system_base(const std::vector<std::vector<double> >& c, 
         std::vector<double> a, 
@@ -107,8 +145,7 @@ std::vector<std::vector<std::pair<double, bool> > >
     auto n = a.size(), m = b.size();
     std::vector<std::vector<std::pair<double, bool> > > base_matrix (n, std::vector<std::pair<double, bool> >(m, std::make_pair(0.0, false)));
 
-    // We can't use cnts_rows or cnts_columns because x(i, j) = a(i) or x(i, j) = b(j)
-    std::vector<unsigned> cnts_rows(n, 0u), cnts_columns(m, 0u);
+    std::vector<bool> active_rows(n, true), active_columns(m, true);
     unsigned used_rows = 0, used_columns = 0;    
     // min heap (priority queue) is used as an optimization for this function for O(n*m*log(n*m)) time complexity
     // instead of O((n+m)*n*m) time complexity
@@ -125,43 +162,207 @@ std::vector<std::vector<std::pair<double, bool> > >
         int j = candidates.top().j;
         candidates.pop();
 
-        if(cnts_rows.at(i) == 0 && cnts_columns.at(j) == 0)
+        if(active_rows.at(i) && active_columns.at(j))
         {
-            double min_ab = std::min(a.at(i), b.at(j));
-            base_matrix.at(i).at(j) = std::make_pair(min_ab, true);
+            allocate_cell(i, j, base_matrix, a, b, active_rows, active_columns, used_rows, used_columns);
             iteration++;
-            a.at(i) -= min_ab;
-            b.at(j) -= min_ab;
+        }
+    }
+
+    return base_matrix;
+}
+
+// Starting base: minimal price method (cheapest free cell first), Vogel's approximation method
+// (cheapest cell of row/column with largest difference of two cheapest cells, ex. regret of not
+// taking cheapest cell) and Russell's method (cell with most negative c(i, j) - u(i) - v(j),
+// u(i)/v(j) ~ largest cost in row/column)
+enum class BaseMethod { MINIMAL_PRICE, VOGEL, RUSSELL };
+
+std::string to_string(BaseMethod method)
+{
+    switch(method)
+    {
+        case BaseMethod::MINIMAL_PRICE: return "minimal price";
+        case BaseMethod::VOGEL: return "vogel";
+        case BaseMethod::RUSSELL: return "russell";
+    }
+    return "";
+}
+
+// indexes of row i sorted by cost (every row once: O(n*m*log(m)))
+std::vector<std::vector<unsigned> > sorted_rows(const std::vector<std::vector<double> >& c)
+{
+    std::vector<std::vector<unsigned> > order(c.size());
+    for(unsigned i=0; i<c.size(); i++)
+    {
+        for(unsigned j=0; j<c.at(i).size(); j++)
+            order.at(i).push_back(j);
+        std::sort(order.at(i).begin(), order.at(i).end(), [&](unsigned first, unsigned second) { return c.at(i).at(first) < c.at(i).at(second); });
+    }
+    return order;
+}
+
+// c transposed (columns become rows)
+std::vector<std::vector<double> > transposed(const std::vector<std::vector<double> >& c)
+{
+    std::vector<std::vector<double> > t(c.at(0).size(), std::vector<double>(c.size()));
+    for(unsigned i=0; i<c.size(); i++)
+        for(unsigned j=0; j<c.at(i).size(); j++)
+            t.at(j).at(i) = c.at(i).at(j);
+    return t;
+}
+
+// position of next active index in order (positions only move forward, because crossed out
+// rows/columns never become active again, so all moves of one line cost O(length of line))
+unsigned next_active(const std::vector<unsigned>& order, unsigned position, const std::vector<bool>& active)
+{
+    while(position < order.size() && !active.at(order.at(position)))
+        position++;
+    return position;
+}
+
+// Vogel's approximation method: penalty of line = difference of its two cheapest active cells
+// (cost of cell if there is only one), cheapest cell of line with largest penalty gets x = min(a, b)
+// Every line keeps positions of its two cheapest active cells in its sorted order, positions
+// only move forward, so one allocation costs O(n+m) and all of them O((n+m)^2) (+ sorting)
+std::vector<std::vector<std::pair<double, bool> > >
+    calculate_system_base_vogel(const std::vector<std::vector<double> >& c,
+        std::vector<double> a,
+        std::vector<double> b)
+{
+    auto n = a.size(), m = b.size();
+    std::vector<std::vector<std::pair<double, bool> > > base_matrix (n, std::vector<std::pair<double, bool> >(m, std::make_pair(0.0, false)));
+    std::vector<bool> active_rows(n, true), active_columns(m, true);
+    unsigned used_rows = 0, used_columns = 0;
+
+    auto ct = transposed(c);
+    auto row_order = sorted_rows(c), column_order = sorted_rows(ct);
+    std::vector<unsigned> row_first(n, 0), row_second(n, 0), column_first(m, 0), column_second(m, 0);
+
+    // (penalty, cheapest cost, cell) of line with given positions of its two cheapest cells
+    auto penalty = [](const std::vector<double>& costs, const std::vector<unsigned>& order, unsigned first, unsigned second)
+    {
+        double cheapest = costs.at(order.at(first));
+        double next = (second < order.size()) ? costs.at(order.at(second)) : 2*cheapest;
+        return std::make_tuple(next - cheapest, cheapest, order.at(first));
+    };
 
-            if(std::fabs(a.at(i)) < EPS && std::fabs(b.at(j)) < EPS)
+    for(unsigned iteration=0; iteration<n+m-1; iteration++)
+    {
+        double best_penalty = -INF, best_cost = INF;
+        unsigned best_i = STOP, best_j = STOP;
+        for(unsigned i=0; i<n; i++)
+        {
+            if(!active_rows.at(i))
+                continue;
+            row_first.at(i) = next_active(row_order.at(i), row_first.at(i), active_columns);
+            row_second.at(i) = next_active(row_order.at(i), std::max(row_second.at(i), row_first.at(i)+1), active_columns);
+            auto[value, cost, j] = penalty(c.at(i), row_order.at(i), row_first.at(i), row_second.at(i));
+            if(value > best_penalty || (value == best_penalty && cost < best_cost))
             {
-                if(used_rows <= used_columns)
-                {
-                    cnts_rows.at(i)++;
-                    used_rows++;
-                }
-                else
-                {
-                    cnts_columns.at(j)++;
-                    used_columns++;
-                }
+                best_penalty = value;
+                best_cost = cost;
+                best_i = i;
+                best_j = j;
             }
-            else if(std::fabs(a.at(i)) < EPS)
+        }
+        for(unsigned j=0; j<m; j++)
+        {
+            if(!active_columns.at(j))
+                continue;
+            column_first.at(j) = next_active(column_order.at(j), column_first.at(j), active_rows);
+            column_second.at(j) = next_active(column_order.at(j), std::max(column_second.at(j), column_first.at(j)+1), active_rows);
+            auto[value, cost, i] = penalty(ct.at(j), column_order.at(j), column_first.at(j), column_second.at(j));
+            if(value > best_penalty || (value == best_penalty && cost < best_cost))
             {
-                cnts_rows.at(i)++;
-                used_rows++;
+                best_penalty = value;
+                best_cost = cost;
+                best_i = i;
+                best_j = j;
             }
-            else
+        }
+        allocate_cell(best_i, best_j, base_matrix, a, b, active_rows, active_columns, used_rows, used_columns);
+    }
+
+    return base_matrix;
+}
+
+// Russell's method: u(i) = largest cost of active cells in row i, v(j) = largest cost in column j,
+// active cell with most negative c(i, j) - u(i) - v(j) gets x = min(a, b)
+// u and v keep positions in sorted orders (from most expensive, positions only move forward),
+// cells are scanned every allocation: O((n+m)*n*m)
+std::vector<std::vector<std::pair<double, bool> > >
+    calculate_system_base_russell(const std::vector<std::vector<double> >& c,
+        std::vector<double> a,
+        std::vector<double> b)
+{
+    auto n = a.size(), m = b.size();
+    std::vector<std::vector<std::pair<double, bool> > > base_matrix (n, std::vector<std::pair<double, bool> >(m, std::make_pair(0.0, false)));
+    std::vector<bool> active_rows(n, true), active_columns(m, true);
+    unsigned used_rows = 0, used_columns = 0;
+
+    auto ct = transposed(c);
+    auto row_order = sorted_rows(c), column_order = sorted_rows(ct);
+    for(auto& order: row_order)
+        std::reverse(order.begin(), order.end());
+    for(auto& order: column_order)
+        std::reverse(order.begin(), order.end());
+    std::vector<unsigned> row_largest(n, 0), column_largest(m, 0);
+    std::vector<double> u(n), v(m);
+
+    for(unsigned iteration=0; iteration<n+m-1; iteration++)
+    {
+        for(unsigned i=0; i<n; i++)
+            if(active_rows.at(i))
             {
-                cnts_columns.at(j)++;
-                used_columns++;
+                row_largest.at(i) = next_active(row_order.at(i), row_largest.at(i), active_columns);
+                u.at(i) = c.at(i).at(row_order.at(i).at(row_largest.at(i)));
+            }
+        for(unsigned j=0; j<m; j++)
+            if(active_columns.at(j))
+            {
+                column_largest.at(j) = next_active(column_order.at(j), column_largest.at(j), active_rows);
+                v.at(j) = c.at(column_order.at(j).at(column_largest.at(j))).at(j);
+            }
+
+        double best = INF;
+        unsigned best_i = STOP, best_j = STOP;
+        for(unsigned i=0; i<n; i++)
+        {
+            if(!active_rows.at(i))
+                continue;
+            for(unsigned j=0; j<m; j++)
+            {
+                if(!active_columns.at(j))
+                    continue;
+                double delta = c.at(i).at(j) - u.at(i) - v.at(j);
+                if(delta < best)
+                {
+                    best = delta;
+                    best_i = i;
+                    best_j = j;
+                }
             }
         }
+        allocate_cell(best_i, best_j, base_matrix, a, b, active_rows, active_columns, used_rows, used_columns);
     }
 
     return base_matrix;
 }
 
+std::vector<std::vector<std::pair<double, bool> > >
+    calculate_start_base(const std::vector<std::vector<double> >& c,
+        const std::vector<double>& a,
+        const std::vector<double>& b,
+        BaseMethod method)
+{
+    if(method == BaseMethod::VOGEL)
+        return calculate_system_base_vogel(c, a, b);
+    if(method == BaseMethod::RUSSELL)
+        return calculate_system_base_russell(c, a, b);
+    return calculate_system_base(c, a, b);
+}
+
 void show_base_matrix(const std::vector<std::vector<std::pair<double, bool> > >& base_matrix)
 {
     std::cout << "base matrix:" << std::endl;
@@ -526,18 +727,29 @@ void show_pseudo_vars(const std::set<unsigned>& pseudo_rows, const std::set<unsi
     std::cout << std::endl; 
 }
 
+// cost of starting base and iterations of potential method (cycle updates)
+struct TransportStats {
+    double start_cost = 0.0;
+    unsigned iterations = 0;
+};
+
 double solve_transport_problem(
     std::vector<std::vector<double> >& c, 
     std::vector<double>& a, 
-    std::vector<double>& b 
+    std::vector<double>& b,
+    BaseMethod method,
+    TransportStats& stats
 )
 {
     std::cout << BAR << BAR << BAR;
     auto[pseudo_rows, pseudo_columns] = add_pseudo_vars(c, a, b);
     show_pseudo_vars(pseudo_rows, pseudo_columns);
     show_system(c, a, b, pseudo_rows, pseudo_columns);
-    // minimal price method:
-    auto base_matrix = calculate_system_base(c, a, b);
+    // minimal price, Vogel's or Russell's method:
+    auto base_matrix = calculate_start_base(c, a, b, method);
+    stats.start_cost = calculate_solution(c, base_matrix, pseudo_rows, pseudo_columns);
+    stats.iterations = 0;
+    std::cout << "starting base (" << to_string(method) << "), cost: " << stats.start_cost << std::endl;
     show_base_matrix(base_matrix);
 
     while(true)
@@ -565,6 +777,7 @@ double solve_transport_problem(
         show_cycle_and_theta(cycle, theta, b.size()); // (m = b.size())
 
         update_system(base_matrix, cycle, theta, theta_i, theta_j);
+        stats.iterations++;
         show_base_matrix(base_matrix);
     }
 }
@@ -572,7 +785,34 @@ double solve_transport_problem(
 int main(int argc, char** argv)
 {
     // *INPUT FILE*
-    const char* path = (argc >= 2) ? argv[1] : "input.txt";
+    // [--base minimal|vogel|russell] [--compare] [file]
+    // --compare ~ task is solved with every starting base (without steps) and report is written
+    const char* path = "input.txt";
+    BaseMethod method = BaseMethod::MINIMAL_PRICE;
+    bool compare = false;
+    for(int i=1; i<argc; i++)
+    {
+        std::string arg = argv[i];
+        if(arg == "--base" && i+1 < argc)
+        {
+            std::string name = argv[++i];
+            if(name == "minimal")
+                method = BaseMethod::MINIMAL_PRICE;
+            else if(name == "vogel")
+                method = BaseMethod::VOGEL;
+            else if(name == "russell")
+                method = BaseMethod::RUSSELL;
+            else
+            {
+                std::cout << "Unknown starting base method \"" << name << "\"!" << std::endl;
+                return 1;
+            }
+        }
+        else if(arg == "--compare")
+            compare = true;
+        else
+            path = argv[i];
+    }
 
     std::ifstream input(path);
     if(input.fail())
@@ -582,7 +822,33 @@ int main(int argc, char** argv)
     }
 
     auto[c, a, b] = read_task(input);
-    solve_transport_problem(c, a, b);
+    if(!compare)
+    {
+        TransportStats stats;
+        solve_transport_problem(c, a, b, method, stats);
+        std::cout << "Starting cost: " << stats.start_cost << " (" << to_string(method) << "), iterations: "
+                  << stats.iterations << std::endl;
+        return 0;
+    }
+
+    // Report: every method gets copy of task, steps of potential method are not written
+    std::cout << std::setw(16) << std::left << "starting base" << std::setw(16) << "starting cost"
+              << std::setw(12) << "iterations" << std::setw(16) << "solution" << "ms" << std::endl;
+    for(auto next: {BaseMethod::MINIMAL_PRICE, BaseMethod::VOGEL, BaseMethod::RUSSELL})
+    {
+        auto c_copy = c;
+        auto a_copy = a;
+        auto b_copy = b;
+        TransportStats stats;
+        auto buffer = std::cout.rdbuf(nullptr);
+        auto start = std::chrono::steady_clock::now();
+        double result = solve_transport_problem(c_copy, a_copy, b_copy, next, stats);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout.rdbuf(buffer);
+        std::cout.clear();
+        std::cout << std::setw(16) << to_string(next) << std::setw(16) << stats.start_cost << std::setw(12)
+                  << stats.iterations << std::setw(16) << result << ms << std::endl;
+    }
     return 0;
 }
 
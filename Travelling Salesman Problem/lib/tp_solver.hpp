@@ -41,6 +41,28 @@ struct cell {
 
 bool operator>(const cell& c1, const cell& c2);
 
+// Starting base: minimal price method (cheapest free cell first), Vogel's approximation method
+// (cheapest cell of row/column with largest difference of two cheapest cells) and Russell's method
+// (cell with most negative c(i, j) - u(i) - v(j), u(i)/v(j) ~ largest cost in row/column)
+enum class BaseMethod { MINIMAL_PRICE, VOGEL, RUSSELL };
+
+std::string to_string(BaseMethod method);
+
+// cost of starting base and iterations of potential method (cycle updates)
+struct TransportStats {
+    double start_cost = 0.0;
+    unsigned iterations = 0;
+};
+
+// x(i, j) = min(a(i), b(j)), exhausted row or column is crossed out (one of them if both are
+// exhausted, never last active row or column), every method gives base with n+m-1 cells
+void allocate_cell(unsigned i, unsigned j,
+    std::vector<std::vector<std::pair<double, bool> > >& base_matrix,
+    std::vector<double>& a, std::vector<double>& b,
+    std::vector<bool>& active_rows, std::vector<bool>& active_columns,
+    unsigned& used_rows, unsigned& used_columns
+);
+
 std::vector<std::vector<std::pair<double, bool> > >
     calculate_system_base(
         const std::vector<std::vector<double> >& c, 
@@ -48,6 +70,36 @@ std::vector<std::vector<std::pair<double, bool> > >
         std::vector<double> b
     );
 
+std::vector<std::vector<unsigned> > sorted_rows(const std::vector<std::vector<double> >& c);
+
+std::vector<std::vector<double> > transposed(const std::vector<std::vector<double> >& c);
+
+unsigned next_active(const std::vector<unsigned>& order, unsigned position, const std::vector<bool>& active);
+
+// O(n*m*log(n*m) + (n+m)^2)
+std::vector<std::vector<std::pair<double, bool> > >
+    calculate_system_base_vogel(
+        const std::vector<std::vector<double> >& c, 
+        std::vector<double> a, 
+        std::vector<double> b
+    );
+
+// O((n+m)*n*m)
+std::vector<std::vector<std::pair<double, bool> > >
+    calculate_system_base_russell(
+        const std::vector<std::vector<double> >& c, 
+        std::vector<double> a, 
+        std::vector<double> b
+    );
+
+std::vector<std::vector<std::pair<double, bool> > >
+    calculate_start_base(
+        const std::vector<std::vector<double> >& c, 
+        const std::vector<double>& a, 
+        const std::vector<double>& b,
+        BaseMethod method
+    );
+
 void show_base_matrix(const std::vector<std::vector<std::pair<double, bool> > >& base_matrix);
 
 std::tuple<bool, unsigned> 
@@ -109,7 +161,9 @@ void show_pseudo_vars(
 std::pair<double, std::vector<std::vector<std::pair<double, bool> > > > solve_transport_problem(
     std::vector<std::vector<double> >& c, 
     std::vector<double>& a, 
-    std::vector<double>& b 
+    std::vector<double>& b,
+    BaseMethod method,
+    TransportStats& stats
 );
 
 #endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <chrono>
 #include "lib/tp_solver.hpp"
 
 #define PSEUDO_INF (1000000000.0)
@@ -57,10 +58,16 @@ std::vector<int> get_cycle(const std::vector<std::vector<std::pair<double, bool>
 
 double record = PSEUDO_INF;
 std::vector<int> record_cycle;
+// starting base of every transport problem, solved transport problems and their potential method iterations
+BaseMethod base_method = BaseMethod::MINIMAL_PRICE;
+unsigned transport_problems = 0, potential_iterations = 0;
 void solve(std::vector<std::vector<double> >& c, std::vector<double>& a, std::vector<double>& b)
 {
     unsigned n = a.size();
-    auto[value, solution] = solve_transport_problem(c, a, b);
+    TransportStats stats;
+    auto[value, solution] = solve_transport_problem(c, a, b, base_method, stats);
+    transport_problems++;
+    potential_iterations += stats.iterations;
     if(value > record)
         return;
 
@@ -94,7 +101,33 @@ void solve(std::vector<std::vector<double> >& c, std::vector<double>& a, std::ve
 int main(int argc, char** argv)
 {
     // *INPUT FILE*
-    const char* path = (argc >= 2) ? argv[1] : "input.txt";
+    // [--base minimal|vogel|russell] [--compare] [file]
+    // --compare ~ task is solved with every starting base (without steps) and report is written
+    const char* path = "input.txt";
+    bool compare = false;
+    for(int i=1; i<argc; i++)
+    {
+        std::string arg = argv[i];
+        if(arg == "--base" && i+1 < argc)
+        {
+            std::string name = argv[++i];
+            if(name == "minimal")
+                base_method = BaseMethod::MINIMAL_PRICE;
+            else if(name == "vogel")
+                base_method = BaseMethod::VOGEL;
+            else if(name == "russell")
+                base_method = BaseMethod::RUSSELL;
+            else
+            {
+                std::cout << "Unknown starting base method \"" << name << "\"!" << std::endl;
+                return 1;
+            }
+        }
+        else if(arg == "--compare")
+            compare = true;
+        else
+            path = argv[i];
+    }
 
     std::ifstream input(path);
     if(input.fail())
@@ -104,6 +137,28 @@ int main(int argc, char** argv)
     }
 
     auto[c, a, b] = read_task(input);
+    if(compare)
+    {
+        // Report: branch and bound is repeated for every method, steps are not written
+        std::cout << std::setw(16) << std::left << "starting base" << std::setw(20) << "transport problems"
+                  << std::setw(12) << "iterations" << std::setw(16) << "solution" << "ms" << std::endl;
+        for(auto next: {BaseMethod::MINIMAL_PRICE, BaseMethod::VOGEL, BaseMethod::RUSSELL})
+        {
+            base_method = next;
+            record = PSEUDO_INF;
+            record_cycle.clear();
+            transport_problems = potential_iterations = 0;
+            auto buffer = std::cout.rdbuf(nullptr);
+            auto start = std::chrono::steady_clock::now();
+            solve(c, a, b);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::cout.rdbuf(buffer);
+            std::cout.clear();
+            std::cout << std::setw(16) << to_string(next) << std::setw(20) << transport_problems << std::setw(12)
+                      << potential_iterations << std::setw(16) << record << ms << std::endl;
+        }
+        return 0;
+    }
     solve(c, a, b);
 
     std::cout << "Final solution: " << record << std::endl;
@@ -111,6 +166,8 @@ int main(int argc, char** argv)
     for(auto c: record_cycle)
         std::cout << c << " ";
     std::cout << std::endl; 
+    std::cout << "Transport problems: " << transport_problems << " (" << to_string(base_method)
+              << "), potential method iterations: " << potential_iterations << std::endl;
 
     return 0;
 }
\ No newline at end of file
@@ -1,381 +1,71 @@
-#include <iostream>
-#include <fstream>
-#include <utility>
-#include <climits>
-#include <cfloat>
-#include <cmath>
-#include <ctime>
-#include <set>
-#include <iomanip>
-#include "../../lib/matrix.hpp"
-
-#define UNUSED_VAR(X) ((void)X)
-
-#define STOP ((unsigned)-1)
-#define INF DBL_MAX
+#include "../../lib/lp_reader.hpp"
+#include "../../lib/simplex.hpp"
 
 #define _DEBUG
-#define BAR "------------------------------------------------------"
-
-// precision: EPS
-#define EPS 0.0001
-
-template<typename T>
-void vector_print(const std::vector<T>& v)
-{
-    for(auto e: v)
-        std::cout << e << " ";
-    std::cout << std::endl;
-}
 
-bool is_not_canonical(const Matrix& A, const Matrix& b, const Matrix& c)
+// Structural columns of system [A | E]: lib solvers give every row logical column N+i,
+// here all rows are equations so logical columns are fixed (0 <= s(i) <= 0)
+Matrix get_upper(const Matrix& A)
 {
-    // Checking if b > 0
-    for(unsigned i=0; i<b.width(); i++)
-        if(b.at(0, i) < -EPS)
-            return true;
-
-    // Checking if b has canonical base
-    // 1 0 ...   0 ...
-    // 0 1 0 ... 0 ...
-    // ...         ...
-    // 0 ...     1 ...
-
-    // fabs(A.at(i, j) - 1) > EPS instead of A.at(i, j) != 1 because of precision
-    // A.at(i, j) might be 0.99999999
-
+    Matrix upper(1, A.width() + A.height(), INF);
     for(unsigned i=0; i<A.height(); i++)
-    {
-        if(std::fabs(c.at(0, i)) > EPS)
-            return true;
-        for(unsigned j=0; j<A.height(); j++)
-        {
-            if(i == j && std::fabs(A.at(i, j)-1) > EPS)
-                return true;
-            else if(i != j && std::fabs(A.at(i, j)) > EPS)
-                return true;
-        }
-    }
-
-    return false;
+        upper.at(0, A.width()+i) = 0.0;
+    return upper;
 }
 
-std::tuple<std::vector<unsigned>, std::vector<unsigned>, double> set_canonical_matrix(Matrix& A, Matrix& b, Matrix& c)
+int main(int argc, char** argv)
 {
-    srand(time(NULL));
-
-    auto n = A.height();
-    auto m = A.width();
-    double Fo = 0.0;
-    // i ~ column, j ~ row
-    while(is_not_canonical(A, b, c)) 
+    std::cout << std::fixed;
+    std::cout << std::setprecision(2);
+    // *INPUT FILE*
+    // --composite ~ single phase instead of phase one (sum of pseudo variables + omega*c*x)
+    const char* path = "input.txt";
+    bool composite = false;
+    for(int i=1; i<argc; i++)
     {
-        for(unsigned i=0; i<n; i++)
-        {
-            if(std::fabs(A.at(i, i)) < EPS || A.at(i, i)*b.at(0, i) < -EPS)
-            {
-                // If b(i) is negative then we have to pick different columns for base
-                // Finding all potential base columns:
-                std::vector<unsigned> potential_base_columns;
-                for(unsigned j=i+1; j<m; j++)
-                    if(A.at(i, j)*b.at(0, i) >= EPS)
-                    {
-                        potential_base_columns.push_back(j);
-                    }
-                unsigned new_column = potential_base_columns.at(0);
-                swap_columns(A, i, new_column);
-                swap_columns(c, i, new_column);
-            }
-            // "clearing" i-th column
-            // "clearing" - Transformation with result of i-th column having
-            // 0s above and below i-th row and 1 for i-th row
-            for(unsigned j=0; j<n; j++)
-            {
-                if(i == j)
-                    continue;
-                double coef = A.at(j, i)/A.at(i, i);
-                for(unsigned k=0; k<m; k++)
-                    A.at(j, k) -= coef*A.at(i, k);
-                b.at(0, j) -= coef*b.at(0, i);
-            }
-            double coef = A.at(i, i);
-            for(unsigned k=0; k<m; k++)
-                A.at(i, k) /= coef;
-            b.at(0, i) /= coef;
-
-            coef = c.at(0, i)/A.at(i, i);
-            for(unsigned k=0; k<m; k++)
-                c.at(0, k) -= coef*A.at(i, k);
-
-            Fo -= coef*b.at(0, i);
-        }
-    }
-
-    std::vector<unsigned> P, Q;
-    for(unsigned i=0; i<m; i++)
-        if(i<n)
-            P.push_back(i);
+        if(std::string(argv[i]) == "--composite")
+            composite = true;
         else
-            Q.push_back(i);
-    return std::make_tuple(P, Q, Fo);
-}
-
-Matrix get_B(const Matrix& A, const std::vector<unsigned>& P)
-{
-    Matrix B = Matrix(A.height(), 0);
-    for(auto p: P)
-        append(B, A.col(p));
-
-    return B;
-}
-
-Matrix get_Cb(const Matrix& c, const std::vector<unsigned>& P)
-{
-    Matrix Cb = Matrix(1, P.size());
-    for(unsigned i=0; i<P.size(); i++)
-        Cb.at(0, i) = c.at(0, P.at(i));
-
-    return Cb;
-}
-
-Matrix get_Kq(const Matrix& A, const std::vector<unsigned>& Q)
-{
-    Matrix Kq = Matrix(A.height(), 0);
-    for(auto q: Q)
-        append(Kq, A.col(q));
-
-    return Kq;
-}
-
-Matrix get_Cq(const Matrix& c, const std::vector<unsigned>& Q)
-{
-    Matrix Cq = Matrix(1, Q.size());
-    for(unsigned i=0; i<Q.size(); i++)
-        Cq.at(0, i) = c.at(0, Q.at(i));
-
-    return Cq;
-}
-
-unsigned get_first_negative(const Matrix& r)
-{
-    for(unsigned i=0; i<r.width(); i++)
-        if(r.at(0, i) < -EPS)
-            return i;
-    return STOP;
-}
-
-// Starting with x: if i in P then we set next unused value of b for x(i) else x(i) = 0
-Matrix get_x(const Matrix& b, const std::vector<unsigned>& P, unsigned size)
-{
-    unsigned j = 0;
-    Matrix x(1, size, 0);
-    for(auto p: P)
-        x.at(0, p) = b.at(0, j++);
-
-    return x;
-}
-
-std::pair<double, unsigned> get_t_opt(const Matrix& x, const Matrix& y, const std::vector<unsigned>& P)
-{
-    double t = INF;
-    unsigned t_index;
-    for(unsigned i=0; i<y.width(); i++)
-    {
-        double val = x.at(0, P.at(i))/y.at(0, i);
-        if(y.at(0, i) > EPS && val < t)
-        {
-            t = val;
-            t_index = P.at(i);
-        }
+            path = argv[i];
     }
 
-    return std::make_pair(t, t_index);
-}
-
-void update_x(Matrix& x, const Matrix& y, unsigned l, const std::vector<unsigned>& P, double t_opt)
-{
-    for(unsigned i=0; i<y.width(); i++)
-    {
-        unsigned index = P.at(i);
-        x.at(0, index) -= y.at(0, i)*t_opt;
-    }
-    x.at(0, l) = t_opt;
-}
-
-void update_P_Q(std::vector<unsigned>& P, std::vector<unsigned>& Q, unsigned t_index, unsigned l)
-{
-    for(auto& p: P)
-        if(p == t_index)
-        {
-            p = l;
-            break;
-        }
-    for(auto& q: Q)
-        if(q == l)
-        {
-            q = t_index;
-            break;
-        }
-}
-
-bool has_all_negative(const Matrix& y)
-{
-    for(unsigned i=0; i<y.width(); i++)
-        if(y.at(0, i) > EPS)
-            return false;
-    return true;
-}
-
-std::pair<double, Matrix> residual_simplex(Matrix& A, Matrix& b, Matrix& c,
-                                           std::vector<unsigned>& P, std::vector<unsigned>& Q, double Fo)
-{
-
-    // Preprocess: Calculating x:
-    auto x = get_x(b, P, c.width());
-    std::cout << "Starting x value: " << x << std::endl;
-    unsigned iteration = 0;
-    while(true)
+    // *TASK INPUT*
+    LPModel model;
+    ReadStats stats;
+    try
     {
-        std::cout << BAR << std::endl;
-        std::cout << "ITERATION " << iteration++ << ":" << std::endl;
-        // Cb ~ contains values from c where c(i) is in Cb if i is in P
-        // P = [1, 3, 4], C = [c1, c2, ... cN] => Cb = [c1, c3, c4]
-
-        // Step1: Solve u*B = Cb <=> u = Cb*B' (B' is inverse matrix of B)
-        // This is equivalent to u*K(i) = c(i) for i in P which is what we need to find optimal value
-
-        auto B = get_B(A, P);
-        auto Cb = get_Cb(c, P);
-        auto u = Cb*B.inv();
-        std::cout << "Step1: Solving system(1): uB = Cb" << std::endl;
-        std::cout << "B:" << std::endl;
-        std::cout << B << std::endl;
-        std::cout << "Cb: " << Cb << std::endl;
-        std::cout << "Result of u(1): " << u << std::endl;
-
-        // Step2: Calculating r
-        // r(j) = c(j) - u*K(j)
-        // if (r >= 0) then we found our optimal value
-        // This is equivalent to (l_index == STOP) which we get from get_first_negative(r)   
-        auto Kq = get_Kq(A, Q);
-        auto Cq = get_Cq(c, Q);
-        auto r = Cq - u*Kq;
-        // K := Kq in output
-        // C := Cq in output
-        std::cout << "Step2: Calculating r (r := C - uK):" << std::endl;
-        std::cout << "C: " << Cq << std::endl;
-        std::cout << "K: " << std::endl;
-        std::cout << Kq << std::endl; 
-        std::cout << "Result(r): " << r << std::endl;
-
-        // If r > 0 then optimal value is found
-        auto l_index = get_first_negative(r);
-        if(l_index == STOP)
-        {
-            std::cout << "(r > 0) is true => optimal value is found!" << std::endl;
-            break;
-        }
-        auto l = Q.at(l_index);
-        std::cout << "Bland's rule: first negative r(i) is r" << l_index << "!" << std::endl;
-
-        // Step3: Solve B*y = Kl <=> y = B'Kl <=> y = B/Kl where r(l) < 0
-        auto Kl = A.col(l);
-        auto y = (B/Kl).transpose();
-        std::cout << "Step3: Solving system(2): By = K" << l_index << std::endl;
-        std::cout << "B:" << std::endl;
-        std::cout << B << std::endl;
-        std::cout << "K" << l << ": " << std::endl << Kl << std::endl;
-        std::cout << "Result of y(2): " << y << std::endl;
-
-        // Step4: If y has all negative values, then there is no optimum value (its not bounded)
-        // Otherwise we get t_opt := min{x(i)/y(i) | y(i) > 0}
-        std::cout << "Step4: check if y <= 0:" << std::endl;
-        if(has_all_negative(y))
-        {
-            std::cout << "Function does not reach optimal value because (y <= 0) is true!" << std::endl;
-            return std::make_pair(0, Matrix());
-        }
-        std::cout << "(y <= 0) is not true!" << std::endl;
-        std::cout << "Finding optimal t:" << std::endl;
-        auto[t_opt, t_index] = get_t_opt(x, y, P);
-        std::cout << "Optimal t: " << t_opt << std::endl;
-        std::cout << "Column " << t_index << " leaves base (P)" << std::endl;
-
-
-        // Step5: With t_opt we can update our x:
-        // x(i) = x_old(i) - t_opt*y(i), for i in P
-        // x(i) = t_opt, for i == l
-        // x(i) = 0, otherwise
-        // We replace t_index in P with l and l in Q with t_index (new base P)
-        std::cout << "Step5: updating x:" << std::endl;
-        std::cout << "Old x: " << x;
-        update_x(x, y, l, P, t_opt);
-        update_P_Q(P, Q, t_index, l);
-        std::cout << "New x: " << x << std::endl;
+        model = read_model(path, false, stats);
     }
-    std::cout << BAR << std::endl;
-
-    // c*(x.transpose()) is matrix with dimension 1x1
-    double F = -Fo + (c*(x.transpose())).at(0, 0);
-    return std::make_pair(F, x);
-}
-
-void show_system(const Matrix& A, const Matrix& b, const Matrix& c)
-{
-    std::cout << "c: " << c << std::endl;
-    std::cout << "A:" << std::endl;
-    std::cout << A << std::endl;
-    std::cout << "b: " << b << std::endl << std::endl;
-}
-
-int main(int argc, char** argv)
-{
-    std::cout << std::fixed;
-    std::cout << std::setprecision(2);
-    // *INPUT FILE*
-    const char* path = (argc >= 2) ? argv[1] : "input.txt";
-
-    std::ifstream input(path);
-    if(input.fail())
+    catch(const std::runtime_error& e)
     {
-        std::cout << "Failed to open \"input.txt\"!" << std::endl;
+        std::cout << e.what() << std::endl;
         return 1;
     }
-
-    // *TASK INPUT*
+    for(unsigned j=0; j<model.cols(); j++)
+        if(model.lower.at(j) != 0.0 || !std::isinf(model.upper.at(j)))
+        {
+            std::cout << "Two-phase simplex solves only systems with x >= 0 (bounds are not supported)!" << std::endl;
+            return 1;
+        }
 
     // n - number of vars
     // m - number of inequalities
-    unsigned n, m;
-    input >> n >> m;
-
-    std::vector<double> in_c(n);
-    std::vector<std::vector<double> > in_A(m, std::vector<double> (n));
-    std::vector<double> in_b(m);
-    std::string eq_sign;
-
-    for(unsigned i=0; i<n; i++)
-        input >> in_c.at(i);
+    unsigned n = model.cols(), m = model.rows();
+    std::vector<std::vector<double> > in_A = model.A.to_dense().to_cpp_matrix();
+    std::vector<double> in_c = model.c, in_b = model.rhs;
+    if(model.maximize)
+        for(auto& value: in_c)
+            value = -value;
 
-    unsigned new_n = n;
-    std::vector<int> equality_columns;
     for(unsigned i=0; i<m; i++)
     {
-        for(unsigned j=0; j<n; j++)
-            input >> in_A.at(i).at(j);
-        input >> eq_sign;
-        input >> in_b.at(i);
-
-        if(eq_sign == "=")
-        {
-            equality_columns.push_back(i);
+        if(model.sense.at(i) == '=')
             continue;
-        }
-        
+
         // if sign is > then transform it to <
-        if(eq_sign == ">")
+        if(model.sense.at(i) == '>')
         {
-            for(unsigned j=0; j<n; j++) 
+            for(unsigned j=0; j<n; j++)
                 in_A.at(i).at(j) *= -1;
             in_b.at(i) *= -1;
         }
@@ -383,26 +73,12 @@ int main(int argc, char** argv)
         // add new var to convert inequation to equation:
         // x1 + x2 + x3 ... xN <= c
         // => x1 + x2 + x3 ... xN + x = c
-        new_n++;
+        for(unsigned k=0; k<m; k++)
+            in_A.at(k).push_back((i == k) ? 1 : 0);
+        in_c.push_back(0);
     }
 
-    std::vector<std::vector<double> > A_unit(m);
-    std::vector<std::vector<double> > c_unit(1, std::vector<double>(m, 0.0));
-    Matrix A_unit_matrix = identity(m); 
-    Matrix c_unit_matrix(c_unit);
     Matrix c(in_c), A(in_A), b(in_b);
-    append(c_unit_matrix, c);
-    append(A_unit_matrix, A);
-    A = A_unit_matrix;
-    c = c_unit_matrix;
-
-    int offset = 0;
-    for(int col: equality_columns)
-    {
-        A = A.remove_column(col - offset);
-        c = c.remove_column(col - offset);
-        offset++;
-    }
 
     // Set b to be positive:
     for(unsigned i=0; i<A.height(); i++)
@@ -414,14 +90,14 @@ int main(int argc, char** argv)
             b.at(0, i) *= -1;
         }
     }
-    
+
     // *PHASE ONE*
-    // STEP1: Creating subgoal system: 
+    // STEP1: Creating subgoal system:
     // (min) w1 + w2 + ... + wN
     // Ew + Ax = b
     // w, x >= 0
     // System Ax = b has solution only if subgoal system has solution equal to zero
-
+    // Base of subgoal system are pseudo variables (B = E and b >= 0 so base is feasible)
 
     Matrix A1 = identity(A.height());
     append(A1, A);
@@ -436,118 +112,106 @@ int main(int argc, char** argv)
         std::cout << "b:"  << std::endl << b << std::endl;
     #endif
 
-    auto[P1, Q1, Fo1] = set_canonical_matrix(A1, b, c1);
-    auto[F1, x1] = residual_simplex(A1, b, c1, P1, Q1, Fo1);
-    UNUSED_VAR(x1);
-
-    if(std::fabs(F1) > EPS)
-    {
-        std::cout << "There is no solution" << std::endl;
-        return 0;
-    }
-
-
-    // STEP2: Removing pseudo variables
-    // STEP1a: Removing all variables that are not in base (their indexes are not in P1)
-    std::set<unsigned> P1_pseudo_indexes;
-    for(auto p: P1)
+    auto upper1 = get_upper(A1);
+    std::vector<unsigned> P1;
+    for(unsigned i=0; i<A1.height(); i++)
+        P1.push_back(i);
+    auto Q1 = get_Q(P1, upper1.width());
+    std::vector<bool> at_upper1(upper1.width(), false);
+
+    // STEP1a (--composite): cost is used before base is feasible:
+    // (min) w1 + w2 + ... + wN + omega*c*x
+    // omega*max|c| starts at COMPOSITE_WEIGHT, while optimal base still has sum of w > 0
+    // omega is divided by COMPOSITE_DECREASE (below COMPOSITE_MIN_WEIGHT or if objective is
+    // unbounded omega = 0, that is phase one), every round continues from base of previous round
+    double omega = 0.0;
+    if(composite)
     {
-        if(p >= A1.height())
-            break;
-        P1_pseudo_indexes.insert(p);
+        double c_max = 0.0;
+        for(unsigned j=0; j<A.width(); j++)
+            c_max = std::max(c_max, std::fabs(c.at(0, j)));
+        if(c_max > 0.0)
+            omega = COMPOSITE_WEIGHT/c_max;
     }
-    
-    // First n (A1.height()) columns are pseudo variables
-    // Columns are removed from right to left so new indexes for matrix variable do not have to be calculated
-    // ex: if we remove column 2 then 3 becomes 2, 3 -> 4, etc but 1 stays 1
-    for(int i=A1.height()-1; i>=0; i--)
-        if(P1_pseudo_indexes.find(i) == P1_pseudo_indexes.end())
-            A1 = A1.remove_column(i);
-
-    #ifdef _DEBUG   
-        std::cout << "pseudo indexes:" << std::endl;   
-        for(auto p: P1_pseudo_indexes)
-            std::cout << p << " ";
-        std::cout << std::endl;
-    #endif
-
-    // pseudo variable: x(i) == w(i)
-    // STEP2a: If pseudo variable x(i) is in base and there are non-zero values in row where A(row, i) == 1
-    // (only one row since x(i) is in base) then we we choose one non-zero value for pivot and "clear" its column
-    // "clear": set all values below and above to 0 and pivot to 1
-
-    // STEP2b: If pseudo variable x(i) is in base and there are no non-zero values in row where A(row, i) == 1
-    // then we remove k-th row and i-th column from matrix
-    for(auto i: P1_pseudo_indexes)
+    while(true)
     {
-        unsigned row; 
-        unsigned pivot = STOP;
-        for(unsigned j=0; j<A1.height(); j++)
-            if(std::fabs(A1.at(j, i)-1) < EPS)
-            {
-                row = j;
-                break;
-            }
-        std::cout << A1 << std::endl;
-
-        for(unsigned j=0; j<A1.width(); j++)
-            if(j != i && std::fabs(A1.at(row, j)) > EPS)
-            {
-                pivot = j;
-                break;
-            }
-
-        // ~STEP2a
-        if(pivot == STOP)
+        for(unsigned j=0; j<A.width(); j++)
+            c1.at(0, A.height()+j) = omega*c.at(0, j);
+        #ifdef _DEBUG
+            std::cout << "omega: " << omega << std::endl;
+        #endif
+        auto x1 = residual_simplex(A1, b, c1, P1, Q1, upper1, at_upper1).second;
+        if(x1.width() == 0 && omega > 0.0)
         {
-            A1 = A1.remove_column(i).remove_row(row);
-            b = b.remove_column(row);
+            omega = 0.0;
             continue;
         }
-
-        // ~STEP2b
-        double value = A1.at(row, pivot);
-        for(unsigned j=0; j<A1.width(); j++)
-            A1.at(row, j) /= value;
-
-        for(unsigned j=0; j<A1.height(); j++)
+        double F1 = 0.0;
+        for(unsigned i=0; i<A.height() && x1.width() != 0; i++)
+            F1 += x1.at(0, i);
+        if(x1.width() == 0 || (F1 > EPS && omega == 0.0))
         {
-            if(j == row)
-                continue;
-            else
-            {
-                double value = A1.at(j, pivot);
-                for(unsigned l=0; l<A1.width(); l++)
-                    A1.at(j, l) -= value;
-            }
+            std::cout << "There is no solution" << std::endl;
+            return 0;
         }
-
-        A1 = A1.remove_column(i);
+        if(F1 <= EPS)
+            break;
+        omega /= COMPOSITE_DECREASE;
+        if(omega < COMPOSITE_MIN_WEIGHT)
+            omega = 0.0;
     }
 
-    auto A2 = A1;
-    auto b2 = b;
+    // STEP2: Pseudo variables become inactive (they are not removed)
+    // Base of phase one is feasible for system Ax = b, so phase two continues from it:
+    // upper bound of pseudo variables is set to 0 (fixed variables never enter base again),
+    // objective is swapped to c2 = [0 | c] and B, x and P are kept
+    // If pseudo variable w(k) is still in base (with value 0), row k of B'A1 decides:
+    // STEP2a: if there are non-zero values in row for columns of A then ratio test of phase two
+    //         moves w(k) out of base when that row is needed
+    // STEP2b: if there are no non-zero values in row for columns of A then rows of A are linearly
+    //         dependent (rho*A = 0 for rho = e(k)*B') and w(k) stays in base with value 0
+    //         (redundant row stays in system, it doesn't change any solution)
+    Matrix c2(1, A1.width());
+    for(unsigned i=0; i<A1.height(); i++)
+        upper1.at(0, i) = 0.0;
+    for(unsigned j=0; j<A.width(); j++)
+        c2.at(0, A.height()+j) = c.at(0, j);
 
     #ifdef _DEBUG
-        std::cout << "new system:" << std::endl;
-        std::cout << "A2:" << std::endl;
-        std::cout << A2 << std::endl;
-        std::cout << "b2:" << std::endl;
-        std::cout << b2 << std::endl;
-        std::cout << "c:" << std::endl;
-        std::cout << c  << std::endl;
+        std::optional<LU> lu;
+        for(unsigned k=0; k<P1.size(); k++)
+        {
+            if(P1.at(k) >= A.height())
+                continue;
+            if(!lu)
+                lu.emplace(get_B(A1, P1));
+            Matrix e(1, P1.size());
+            e.at(0, k) = 1.0;
+            auto rho = lu->solve_transposed(e);
+
+            bool dependent = true;
+            for(unsigned j=A.height(); j<A1.width() && dependent; j++)
+                if(std::fabs(dot_column(A1, rho, j)) > EPS)
+                    dependent = false;
+            std::cout << "pseudo variable " << P1.at(k) << " is in base" << (dependent ? " (redundant row)" : "")
+                      << ", rho: " << rho;
+        }
+        std::cout << "c2:" << std::endl << c2 << std::endl;
     #endif
 
     // *PHASE TWO*
-    // Solve new system:
+    // Solve system from base of phase one:
     // (min) c*x
-    // where A2*x = b2 and x >= 0
-
-    auto[P2, Q2, Fo2] = set_canonical_matrix(A2, b2, c);
-    auto[F2, x2] = residual_simplex(A2, b2, c, P2, Q2, Fo2);
+    // where A*x = b and x >= 0
+    auto[F2, x2] = residual_simplex(A1, b, c2, P1, Q1, upper1, at_upper1);
+    if(x2.width() == 0)
+        return 0;
 
-    std::cout << "Solution: " << x2;
-    std::cout << "Optimal value: " << F2 << std::endl;
+    Matrix solution(1, A.width());
+    for(unsigned j=0; j<A.width(); j++)
+        solution.at(0, j) = x2.at(0, A.height()+j);
+    std::cout << "Solution: " << solution;
+    std::cout << "Optimal value: " << (model.maximize ? -F2 : F2) + model.c0 << std::endl;
 
     return 0;
 }
\ No newline at end of file
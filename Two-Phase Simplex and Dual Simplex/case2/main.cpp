@@ -1,36 +1,40 @@
-#include <iostream>
-#include <fstream>
-#include <utility>
-#include <climits>
-#include <cfloat>
-#include <cmath>
-#include <ctime>
-#include <iomanip>
-#include <vector>
-#include "../../lib/matrix.hpp"
-
-#define STOP ((unsigned)-1)
-#define INF DBL_MAX
-
-#define BAR "------------------------------------------------------------------------------------------------------------"
-
-// precision: EPS
-#define EPS 0.0001
-
-template<typename T>
-void vector_print(const std::vector<T>& v)
-{
-    for(auto e: v)
-        std::cout << e << " ";
-    std::cout << std::endl;
-}
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include "../../lib/lp_solver.hpp"
+
+// tableau with at least this many values (M*N) is updated by more threads (blocks of rows)
+#define TABLEAU_PARALLEL 100000
+
+// pivots of every run of --bench
+#define BENCH_PIVOTS 10
+
+// Tableau [A | b] with row [c | F] under it (row M), every row is packed (N+1 values in one array),
+// so row operations run over contiguous memory
+struct Tableau {
+    unsigned n, m;
+    std::vector<std::vector<double> > rows;
+
+    Tableau(unsigned height, unsigned width)
+        : n(width), m(height), rows(height+1, std::vector<double>(width+1, 0.0)) {}
+
+    double& A(unsigned i, unsigned j) { return rows[i][j]; }
+    double A(unsigned i, unsigned j) const { return rows[i][j]; }
+    double b(unsigned i) const { return rows[i][n]; }
+    double c(unsigned j) const { return rows[m][j]; }
+    double F() const { return rows[m][n]; }
+};
 
-void show_system(const Matrix& A, const Matrix& b, const Matrix& c, double F)
+void show_system(const Tableau& T)
 {
-    unsigned n = A.width();
-    unsigned m = A.height();
+    unsigned n = T.n;
+    unsigned m = T.m;
     unsigned dim = 10;
-        unsigned dashes_cnt = (dim+3)*n+dim;
+    unsigned dashes_cnt = (dim+3)*n+dim;
     std::string dashes(dashes_cnt, '-');
 
     for(unsigned i=0; i<n; i++)
@@ -42,56 +46,47 @@ void show_system(const Matrix& A, const Matrix& b, const Matrix& c, double F)
     std::cout << "b" << std::endl;
 
     std::cout << dashes << std::endl;
-    for(unsigned i=0; i<m; i++)
+    for(unsigned i=0; i<=m; i++)
     {
+        if(i == m)
+            std::cout << dashes << std::endl;
         for(unsigned j=0; j<n-1; j++)
         {
             std::cout.width(dim);
-            std::cout << A.at(i, j) << "   ";
+            std::cout << T.A(i, j) << "   ";
         }
         std::cout.width(dim);
-        std::cout << A.at(i, n-1) << " | ";
-        std::cout.width(dim);
-        std::cout << b.at(0, i) << std::endl;
-    }
-    std::cout << dashes << std::endl;
-    for(unsigned j=0; j<n-1; j++)
-    {
+        std::cout << T.A(i, n-1) << " | ";
         std::cout.width(dim);
-        std::cout << c.at(0, j) << "   ";
+        std::cout << T.A(i, n) << std::endl;
     }
-    std::cout.width(dim);
-    std::cout << c.at(0, n-1) << " | ";
-    std::cout.width(dim);
-    std::cout << F << std::endl;
     std::cout << std::endl;
-
 }
 
-unsigned is_non_negative(const Matrix& b)
+unsigned is_non_negative(const Tableau& T)
 {
-    for(unsigned i=0; i<b.width(); i++)
-        if(b.at(0, i) < 0)
+    for(unsigned i=0; i<T.m; i++)
+        if(T.b(i) < 0)
             return i;
     return STOP;
 }
 
-unsigned is_non_negative_row(const Matrix& A, unsigned row)
+unsigned is_non_negative_row(const Tableau& T, unsigned row)
 {
-    for(unsigned i=0; i<A.width(); i++)
-        if(A.at(row, i) < 0)
+    for(unsigned i=0; i<T.n; i++)
+        if(T.A(row, i) < 0)
             return i;
     return STOP;
 }
 
-unsigned find_pivot(const Matrix& A, const Matrix& c, unsigned row)
+unsigned find_pivot(const Tableau& T, unsigned row)
 {
-    unsigned pivot_index;
+    unsigned pivot_index = STOP;
     double max_value = -INF;
-    for(unsigned i=0; i<A.width(); i++)
-        if(A.at(row, i) < 0)
+    for(unsigned i=0; i<T.n; i++)
+        if(T.A(row, i) < 0)
         {
-            double value = c.at(0, i)/A.at(row, i);
+            double value = T.c(i)/T.A(row, i);
             if(value > max_value)
             {
                 max_value = value;
@@ -101,7 +96,137 @@ unsigned find_pivot(const Matrix& A, const Matrix& c, unsigned row)
     return pivot_index;
 }
 
-void update_system(Matrix& A, Matrix& b, Matrix& c, double& F, unsigned p_row, unsigned p_col)
+// y = y + a*x (size values), 4 values in every vector operation (GCC vector extension:
+// SSE2/AVX on x86, NEON on ARM), rest is scalar
+typedef double pack __attribute__((vector_size(4*sizeof(double)), aligned(sizeof(double)), may_alias));
+
+void axpy(double* y, const double* x, double a, unsigned size)
+{
+    pack va = {a, a, a, a};
+    unsigned j = 0;
+    for(; j+4<=size; j+=4)
+        *(pack*)(y+j) += va*(*(const pack*)(x+j));
+    for(; j<size; j++)
+        y[j] += a*x[j];
+}
+
+// Worker threads of tableau update: threads are started once for whole solve (or bench) and
+// wait for next pivot, so pivot doesn't create and join threads
+// Caller is worker 0, run(job) runs job(t) for every worker t and returns when all are finished
+class WorkerPool {
+private:
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_start, m_done;
+    const std::function<void(unsigned)>* m_job = nullptr;
+    unsigned long m_generation = 0;
+    unsigned m_running = 0;
+    bool m_stop = false;
+
+    void work(unsigned worker)
+    {
+        unsigned long generation = 0;
+        while(true)
+        {
+            const std::function<void(unsigned)>* job;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_start.wait(lock, [&]() { return m_stop || m_generation != generation; });
+                if(m_stop)
+                    return;
+                generation = m_generation;
+                job = m_job;
+            }
+            (*job)(worker);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(--m_running == 0)
+                m_done.notify_one();
+        }
+    }
+
+public:
+    // threads = 0 ~ all cores
+    WorkerPool(unsigned threads)
+    {
+        if(threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        for(unsigned t=1; t<threads; t++)
+            m_threads.emplace_back(&WorkerPool::work, this, t);
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for(auto& thread: m_threads)
+            thread.join();
+    }
+
+    unsigned size() const
+    {
+        return m_threads.size() + 1;
+    }
+
+    void run(const std::function<void(unsigned)>& job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = &job;
+            m_running = m_threads.size();
+            m_generation++;
+        }
+        m_start.notify_all();
+        job(0);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [&]() { return m_running == 0; });
+    }
+};
+
+// Pivot on T(p_row, p_col): pivot row is divided by pivot and packed copy of it is subtracted
+// from every other row (objective row too) with multiplier coef = -T(i, p_col)
+// Rows with coef = 0 don't change and are skipped, for tableau with at least TABLEAU_PARALLEL
+// values rows are split in blocks between workers of pool (nullptr ~ 1 thread)
+void update_system(Tableau& T, unsigned p_row, unsigned p_col, WorkerPool* pool = nullptr)
+{
+    unsigned width = T.n + 1;
+    // divide row of pivot by its value
+    double coef = T.A(p_row, p_col);
+    for(auto& value: T.rows[p_row])
+        value /= coef;
+    std::vector<double> pivot_row = T.rows[p_row];
+    const double* pivot = pivot_row.data();
+
+    // "clear" p_col column in rows [begin, end)
+    auto clear = [&T, p_row, p_col, pivot, width](unsigned begin, unsigned end) {
+        for(unsigned i=begin; i<end; i++)
+        {
+            double coef = -T.A(i, p_col);
+            if(i == p_row || coef == 0.0)
+                continue;
+            axpy(T.rows[i].data(), pivot, coef, width);
+            T.A(i, p_col) = 0.0;
+        }
+    };
+
+    unsigned rows = T.m + 1;
+    unsigned threads = pool ? std::min(pool->size(), rows) : 1;
+    if((unsigned long)rows*width < TABLEAU_PARALLEL || threads <= 1)
+    {
+        clear(0, rows);
+        return;
+    }
+    unsigned block = (rows + threads - 1)/threads;
+    pool->run([&](unsigned worker) {
+        clear(std::min(worker*block, rows), std::min((worker + 1)*block, rows));
+    });
+}
+
+// Scalar update of tableau kept in Matrix (A, b, c and F apart, every row is updated),
+// used by --bench as reference
+void update_system_reference(Matrix& A, Matrix& b, Matrix& c, double& F, unsigned p_row, unsigned p_col)
 {
     unsigned n = A.width();
     unsigned m = A.height();
@@ -122,55 +247,31 @@ void update_system(Matrix& A, Matrix& b, Matrix& c, double& F, unsigned p_row, u
     }
     coef = -c.at(0, p_col);
     for(unsigned j=0; j<n; j++)
-            c.at(0, j) += coef*A.at(p_row, j);
+        c.at(0, j) += coef*A.at(p_row, j);
     F += coef*b.at(0, p_row);
 }
 
-int main(int argc, char** argv)
+// Dense tableau dual simplex (--tableau): every iteration updates whole tableau [A | b] and c
+int tableau_dual_simplex(const LPModel& model, unsigned threads)
 {
-    std::cout << std::fixed;
-    std::cout << std::setprecision(2);
-
-    // *INPUT FILE*
-    const char* path = (argc >= 2) ? argv[1] : "input.txt";
-
-    std::ifstream input(path);
-    if(input.fail())
-    {
-        std::cout << "Failed to open \"input.txt\"!" << std::endl;
-        return 1;
-    }
-
-    // *TASK INPUT*
-
     // n - number of vars
     // m - number of inequalities
-    unsigned n, m;
-    input >> n >> m;
-
-    std::vector<double> in_c(n);
-    std::vector<std::vector<double> > in_A(m, std::vector<double> (n));
-    std::vector<double> in_b(m);
-    std::string eq_sign;
-
-    for(unsigned i=0; i<n; i++)
-        input >> in_c.at(i);
+    unsigned n = model.cols(), m = model.rows();
+    std::vector<std::vector<double> > in_A = model.A.to_dense().to_cpp_matrix();
+    std::vector<double> in_c = model.c, in_b = model.rhs;
+    if(model.maximize)
+        for(auto& value: in_c)
+            value = -value;
 
-    unsigned new_n = n;
     for(unsigned i=0; i<m; i++)
     {
-        for(unsigned j=0; j<n; j++)
-            input >> in_A.at(i).at(j);
-        input >> eq_sign;
-        input >> in_b.at(i);
-
-        if(eq_sign == "=")
+        if(model.sense.at(i) == '=')
             continue;
-        
+
         // if sign is > then transform it to <
-        if(eq_sign == ">")
+        if(model.sense.at(i) == '>')
         {
-            for(unsigned j=0; j<n; j++) 
+            for(unsigned j=0; j<n; j++)
                 in_A.at(i).at(j) *= -1;
             in_b.at(i) *= -1;
         }
@@ -178,16 +279,20 @@ int main(int argc, char** argv)
         // add new var to convert inequation to equation:
         // x1 + x2 + x3 ... xN <= c
         // => x1 + x2 + x3 ... xN + x = c
-        new_n++;
         for(unsigned j=0; j<m; j++)
             in_A.at(j).push_back((i==j) ? 1 : 0);
         in_c.push_back(0);
     }
 
-    Matrix c(in_c), A(in_A), b(in_b);
-    double F = 0;
-    show_system(A, b, c, F);
-
+    Tableau T(m, in_c.size());
+    for(unsigned i=0; i<m; i++)
+    {
+        std::copy(in_A.at(i).begin(), in_A.at(i).end(), T.rows[i].begin());
+        T.rows[i][T.n] = in_b.at(i);
+    }
+    std::copy(in_c.begin(), in_c.end(), T.rows[m].begin());
+    show_system(T);
+    WorkerPool pool(threads);
     unsigned iteration = 0;
     while(true)
     {
@@ -197,13 +302,13 @@ int main(int argc, char** argv)
         // If NO  then: exists i such that b(i) < 0 => STEP2
         std::cout << "STEP1: Is b >= 0?" << std::endl;
         unsigned b_negative_index;
-        if((b_negative_index = is_non_negative(b)) == STOP)
+        if((b_negative_index = is_non_negative(T)) == STOP)
         {
             std::cout << "YES! optimal value is found!" << std::endl;
             std::cout << std::endl;
-            std::cout << "Optimal value: " << -F << std::endl;
+            std::cout << "Optimal value: " << (model.maximize ? T.F() : -T.F()) + model.c0 << std::endl;
             return 0;
-        } 
+        }
         else
         {
             std::cout << "NO! b(" << b_negative_index << ") is negative." << std::endl;
@@ -213,7 +318,7 @@ int main(int argc, char** argv)
             // If NO  then: exists j such that A(b_negative_index, j) < 0
             std::cout << "STEP2: Is A(" << b_negative_index <<") >= 0?" << std::endl;
             unsigned A_negative_index;
-            if((A_negative_index = is_non_negative_row(A, b_negative_index)) == STOP)
+            if((A_negative_index = is_non_negative_row(T, b_negative_index)) == STOP)
             {
                 std::cout << "YES! There is no solution!" << std::endl;
                 return 0;
@@ -224,17 +329,166 @@ int main(int argc, char** argv)
                 std::cout << std::endl;
 
                 // STEP3: Finding max c(j)/A(b_negative_index, j) such that A(b_negative_index, j) < 0
-                std::cout << "STEP3: Finding max c(j)/A(" << b_negative_index 
+                std::cout << "STEP3: Finding max c(j)/A(" << b_negative_index
                         << ", j) such that A(" << b_negative_index << ", j) < 0" << std::endl;
-                unsigned pivot_index = find_pivot(A, c, b_negative_index);
+                unsigned pivot_index = find_pivot(T, b_negative_index);
                 std::cout << "Pivot: A(" << b_negative_index << ", " <<  pivot_index << ")" << std::endl;
                 std::cout << std::endl;
-                
-                update_system(A, b, c, F, b_negative_index, pivot_index);
-                show_system(A, b, c, F);
+
+                update_system(T, b_negative_index, pivot_index, &pool);
+                show_system(T);
             }
         }
     }
 
+    return 0;
+}
+
+// --bench MxN[:D]: random tableau M x N (every column has about D*M non-zero values) is pivoted
+// BENCH_PIVOTS times by scalar update of Matrix tableau (reference), by packed rows with 1 thread
+// and by packed rows with given threads, results of all updates must be same
+int bench(const std::string& size, unsigned threads)
+{
+    unsigned m = 0, n = 0;
+    double density = 1.0;
+    if(std::sscanf(size.c_str(), "%ux%u:%lf", &m, &n, &density) < 2 || m == 0 || n == 0 || density <= 0.0 || density > 1.0)
+    {
+        std::cout << "Wrong size of tableau: " << size << " (MxN[:D] is expected)!" << std::endl;
+        return 1;
+    }
+    if(threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> value(-10.0, 10.0), chance(0.0, 1.0);
+    Tableau T(m, n);
+    for(auto& row: T.rows)
+        for(unsigned j=0; j<n; j++)
+            row[j] = (chance(generator) < density) ? value(generator) : 0.0;
+    // pivots: random row, column with largest |value| in that row
+    std::vector<std::pair<unsigned, unsigned> > pivots;
+    std::uniform_int_distribution<unsigned> random_row(0, m-1);
+    for(unsigned k=0; k<BENCH_PIVOTS; k++)
+    {
+        unsigned row = random_row(generator);
+        pivots.push_back(std::make_pair(row, (unsigned)(std::max_element(T.rows[row].begin(), T.rows[row].begin() + n,
+            [](double a, double b) { return std::fabs(a) < std::fabs(b); }) - T.rows[row].begin())));
+    }
+
+    auto run = [&pivots](const std::function<void(unsigned, unsigned)>& pivot) {
+        auto begin = std::chrono::steady_clock::now();
+        for(auto[row, col]: pivots)
+            pivot(row, col);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count()/pivots.size();
+    };
+
+    Matrix A(m, n), b(1, m), c(1, n);
+    double F = T.F();
+    for(unsigned i=0; i<m; i++)
+    {
+        for(unsigned j=0; j<n; j++)
+            A.at(i, j) = T.A(i, j);
+        b.at(0, i) = T.b(i);
+    }
+    for(unsigned j=0; j<n; j++)
+        c.at(0, j) = T.c(j);
+    double reference = run([&](unsigned row, unsigned col) { update_system_reference(A, b, c, F, row, col); });
+
+    Tableau T1 = T;
+    double packed = run([&](unsigned row, unsigned col) { update_system(T1, row, col); });
+    WorkerPool pool(threads);
+    double parallel = run([&](unsigned row, unsigned col) { update_system(T, row, col, &pool); });
+
+    double difference = 0.0;
+    for(unsigned i=0; i<=m; i++)
+        for(unsigned j=0; j<=n; j++)
+        {
+            double expected = (i == m) ? ((j == n) ? F : c.at(0, j)) : ((j == n) ? b.at(0, i) : A.at(i, j));
+            difference = std::max({difference, std::fabs(T1.A(i, j) - expected), std::fabs(T.A(i, j) - expected)});
+        }
+
+    std::cout << "tableau " << m << "x" << n << " (density " << density << "), " << pivots.size() << " pivots" << std::endl;
+    std::cout << "update                  | ms per pivot | speedup" << std::endl;
+    std::cout << "------------------------|--------------|--------" << std::endl;
+    std::cout << "scalar (Matrix)         | " << std::setw(12) << reference << " | 1.00" << std::endl;
+    std::cout << "packed, 1 thread        | " << std::setw(12) << packed << " | " << reference/packed << std::endl;
+    std::cout << "packed, " << std::setw(2) << threads << " threads      | " << std::setw(12) << parallel << " | " << reference/parallel << std::endl;
+    std::cout << "max difference: " << std::scientific << difference << std::endl;
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << std::fixed;
+    std::cout << std::setprecision(2);
+
+    // *INPUT FILE*
+    const char* path = "input.txt";
+    bool tableau = false;
+    unsigned threads = 0;
+    std::string bench_size;
+    for(int i=1; i<argc; i++)
+    {
+        std::string arg = argv[i];
+        if(arg == "--tableau")
+            tableau = true;
+        else if(arg == "--threads" && i+1 < argc)
+            threads = std::atoi(argv[++i]);
+        else if(arg == "--bench" && i+1 < argc)
+            bench_size = argv[++i];
+        else
+            path = argv[i];
+    }
+    if(!bench_size.empty())
+        return bench(bench_size, threads);
+
+    // *TASK INPUT*
+    LPModel model;
+    ReadStats stats;
+    try
+    {
+        model = read_model(path, false, stats);
+    }
+    catch(const std::runtime_error& e)
+    {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    for(unsigned j=0; j<model.cols(); j++)
+        if(model.lower.at(j) != 0.0 || !std::isinf(model.upper.at(j)))
+        {
+            std::cout << "Dual simplex solves only systems with x >= 0 (bounds are not supported)!" << std::endl;
+            return 1;
+        }
+
+    if(tableau)
+        return tableau_dual_simplex(model, threads);
+
+    // Revised dual simplex (lib dual_simplex): starts from slack base, only pivot row and
+    // pivot column of B'A are calculated, leaving row is chosen by dual steepest edge
+    Solver solver;
+    solver.load(model);
+    solver.set_method(SolverMethod::DUAL);
+    solver.set_scaling(false);
+    solver.set_log(&std::cout);
+    auto status = solver.solve();
+    if(status == SolverStatus::INFEASIBLE)
+    {
+        std::cout << "There is no solution!" << std::endl;
+        return 0;
+    }
+    if(status == SolverStatus::UNBOUNDED)
+    {
+        std::cout << "System is unbounded!" << std::endl;
+        return 0;
+    }
+    if(status != SolverStatus::OPTIMAL)
+    {
+        std::cout << "Dual simplex failed (" << to_string(status) << ")!" << std::endl;
+        return 0;
+    }
+    std::cout << "Solution: " << Matrix(solver.x());
+    std::cout << "Optimal value: " << solver.objective() << std::endl;
+
     return 0;
 }
\ No newline at end of file
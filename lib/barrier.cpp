@@ -0,0 +1,472 @@
+#include "barrier.hpp"
+#include <optional>
+
+// Column j of system [A | E] as (row, value) pairs of non-zero values
+static std::vector<std::pair<unsigned, double> > sparse_column(const Matrix& A, unsigned j)
+{
+    std::vector<std::pair<unsigned, double> > column;
+    if(is_logical(A, j))
+        column.push_back(std::make_pair(j - A.width(), 1.0));
+    else
+        for(unsigned i=0; i<A.height(); i++)
+            if(A.at(i, j) != 0.0)
+                column.push_back(std::make_pair(i, A.at(i, j)));
+    return column;
+}
+
+static double norm_inf(const std::vector<double>& v)
+{
+    double norm = 0.0;
+    for(auto value: v)
+        norm = std::max(norm, std::fabs(value));
+    return norm;
+}
+
+static double dot(const std::vector<double>& u, const std::vector<double>& v)
+{
+    double sum = 0.0;
+    for(unsigned i=0; i<u.size(); i++)
+        sum += u[i]*v[i];
+    return sum;
+}
+
+// Largest alpha in [0, 1] such that v + alpha*dv >= 0 (only entries with mask(i) = true are checked)
+static double max_step(const std::vector<double>& v, const std::vector<double>& dv, const std::vector<bool>& mask)
+{
+    double alpha = 1.0;
+    for(unsigned i=0; i<v.size(); i++)
+        if(mask[i] && dv[i] < 0.0)
+            alpha = std::min(alpha, -v[i]/dv[i]);
+    return alpha;
+}
+
+// Cholesky factorization of A*D*A^T, if it is (numerically) singular diagonal is regularized
+// (throws std::invalid_argument if regularization does not help)
+static Cholesky factorize(Matrix M, unsigned threads)
+{
+    double max_diagonal = 0.0;
+    for(unsigned i=0; i<M.height(); i++)
+        max_diagonal = std::max(max_diagonal, M.at(i, i));
+    double regularization = 1e-14*(1 + max_diagonal);
+    for(unsigned attempt=0; ; attempt++)
+    {
+        try
+        {
+            ScopedTimer timer(counters().factorization_time);
+            counters().factorizations++;
+            return Cholesky(M, threads);
+        }
+        catch(const std::invalid_argument&)
+        {
+            if(attempt == 8)
+                throw;
+            for(unsigned i=0; i<M.height(); i++)
+                M.at(i, i) += regularization;
+            regularization *= 100;
+        }
+    }
+}
+
+std::pair<double, Matrix> barrier(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper,
+                                  unsigned threads, const std::atomic<bool>* cancel, BarrierStatus* status)
+{
+    auto m = A.height();
+    auto N = A.width() + m;
+
+    // Preprocess: active columns (u > 0) and their non-zero values
+    // x ~ primal variables, w = u - x ~ slack of upper bound (only for bounded columns)
+    // y ~ dual variables of rows, z ~ dual variables of x >= 0, v ~ dual variables of w >= 0
+    std::vector<unsigned> J;
+    for(unsigned j=0; j<N; j++)
+        if(upper.at(0, j) > 0.0)
+            J.push_back(j);
+    unsigned k = J.size();
+    std::vector<std::vector<std::pair<unsigned, double> > > K(k);
+    std::vector<double> cost(k), u(k, 0.0);
+    std::vector<bool> all(k, true), bounded(k, false);
+    unsigned bounded_count = 0;
+    for(unsigned q=0; q<k; q++)
+    {
+        K[q] = sparse_column(A, J[q]);
+        cost[q] = get_cost(c, J[q]);
+        if(upper.at(0, J[q]) < INF)
+        {
+            bounded[q] = true;
+            u[q] = upper.at(0, J[q]);
+            bounded_count++;
+        }
+    }
+    std::vector<double> rhs_b(m);
+    for(unsigned i=0; i<m; i++)
+        rhs_b[i] = b.at(0, i);
+
+    auto A_times = [&](const std::vector<double>& x) {
+        std::vector<double> result(m, 0.0);
+        for(unsigned q=0; q<k; q++)
+            if(x[q] != 0.0)
+                for(auto[i, a]: K[q])
+                    result[i] += a*x[q];
+        return result;
+    };
+    auto A_transposed_times = [&](const std::vector<double>& y) {
+        std::vector<double> result(k, 0.0);
+        for(unsigned q=0; q<k; q++)
+            for(auto[i, a]: K[q])
+                result[q] += a*y[i];
+        return result;
+    };
+
+    // A*D*A^T for diagonal D = d (only lower triangle is formed)
+    auto normal_matrix = [&](const std::vector<double>& d) {
+        Matrix M(m, m);
+        for(unsigned q=0; q<k; q++)
+            for(auto[i, a]: K[q])
+                for(auto[l, a2]: K[q])
+                    if(l <= i)
+                        M.at(i, l) += d[q]*a*a2;
+        return M;
+    };
+    auto solve_normal = [&](const Cholesky& cholesky, const std::vector<double>& r) {
+        Matrix rhs(m, 1);
+        for(unsigned i=0; i<m; i++)
+            rhs.at(i, 0) = r[i];
+        auto solution = cholesky.solve(rhs);
+        std::vector<double> result(m);
+        for(unsigned i=0; i<m; i++)
+            result[i] = solution.at(i, 0);
+        return result;
+    };
+
+    // Starting point (Mehrotra): x~ = A^T*(A*A^T)^-1*b is smallest x with Ax = b,
+    // y = (A*A^T)^-1*A*c and z~ - v~ = c - A^T*y is smallest dual slack (z~ = max(s, 0) and
+    // v~ = max(-s, 0) for bounded columns), both are shifted by 1.5*(most negative value) and
+    // then by 0.5*(x*z + w*v)/sum(z + v) (x) and 0.5*(x*z + w*v)/sum(x + w) (z and v), so starting
+    // point is positive and its size follows size of b and c (second shift is at least
+    // BARRIER_MIN_SHIFT*(1 + |x|) for x and BARRIER_MIN_SHIFT*(1 + |c|) for z, ex. x~*z~ = 0)
+    // Bounded columns: x is kept at least min(shift, u/2) below u (w = u - x > 0)
+    std::vector<double> x(k), w(k, 0.0), z(k), v(k, 0.0), y(m, 0.0);
+    try
+    {
+        auto cholesky = factorize(normal_matrix(std::vector<double>(k, 1.0)), threads);
+        x = A_transposed_times(solve_normal(cholesky, rhs_b));
+        y = solve_normal(cholesky, A_times(cost));
+    }
+    catch(const std::invalid_argument&)
+    {
+        x.assign(k, 0.0);
+        y.assign(m, 0.0);
+    }
+    auto ATy = A_transposed_times(y);
+    double min_x = 0.0, min_z = 0.0;
+    for(unsigned q=0; q<k; q++)
+    {
+        double s = cost[q] - ATy[q];
+        z[q] = bounded[q] ? std::max(s, 0.0) : s;
+        v[q] = bounded[q] ? std::max(-s, 0.0) : 0.0;
+        min_x = std::min(min_x, x[q]);
+        min_z = std::min(min_z, z[q]);
+    }
+    for(unsigned q=0; q<k; q++)
+    {
+        x[q] -= 1.5*min_x;
+        z[q] -= 1.5*min_z;
+        if(bounded[q])
+        {
+            x[q] = std::min(x[q], u[q]);
+            w[q] = u[q] - x[q];
+        }
+    }
+    double products = dot(x, z) + dot(w, v), sum_x = 0.0, sum_z = 0.0;
+    for(unsigned q=0; q<k; q++)
+    {
+        sum_x += x[q] + w[q];
+        sum_z += z[q] + v[q];
+    }
+    double shift_x = (products > 0.0) ? 0.5*products/sum_z : 0.0;
+    double shift_z = (products > 0.0) ? 0.5*products/sum_x : 0.0;
+    shift_x = std::max(shift_x, BARRIER_MIN_SHIFT*(1 + norm_inf(x)));
+    shift_z = std::max(shift_z, BARRIER_MIN_SHIFT*(1 + norm_inf(cost)));
+    for(unsigned q=0; q<k; q++)
+    {
+        x[q] += shift_x;
+        z[q] += shift_z;
+        if(bounded[q])
+        {
+            x[q] = std::min(x[q], u[q] - std::min(shift_x, u[q]/2));
+            w[q] = u[q] - x[q];
+            v[q] += shift_z;
+        }
+    }
+
+    double b_norm = norm_inf(rhs_b), c_norm = norm_inf(cost), u_norm = norm_inf(u);
+
+    // Iterates of infeasible or unbounded system diverge, their direction is certificate of it:
+    // Farkas: y' = y/|y| with A(j)*y' <= 0 for columns without upper bound and
+    // b*y' - sum(u(j)*max(A(j)*y', 0)) > 0 for bounded columns => no x in bounds has Ax = b
+    // (A(j)*y' > 0 of unbounded column is allowed up to BARRIER_CERTIFICATE_TOL*(b*y' - ...), any
+    // solution would then need sum of x(j) of size 1/BARRIER_CERTIFICATE_TOL)
+    auto is_infeasible = [&]() {
+        double size = norm_inf(y);
+        if(size == 0.0)
+            return false;
+        std::vector<double> direction(m);
+        for(unsigned i=0; i<m; i++)
+            direction[i] = y[i]/size;
+        auto ATd = A_transposed_times(direction);
+        double value = dot(rhs_b, direction), violation = 0.0;
+        for(unsigned q=0; q<k; q++)
+        {
+            if(bounded[q])
+                value -= u[q]*std::max(ATd[q], 0.0);
+            else
+                violation = std::max(violation, ATd[q]);
+        }
+        return value > BARRIER_TOL*(1 + b_norm + u_norm) && violation <= BARRIER_CERTIFICATE_TOL*value;
+    };
+    // Ray: d = x/|x| of columns without upper bound with A*d = 0 (up to BARRIER_CERTIFICATE_TOL*|c*d|) and
+    // c*d < 0 => dual system has no solution, so system is infeasible or unbounded (unbounded if
+    // x is feasible, x of unbounded system often reaches ray before rounding errors of its size
+    // hide feasibility, then only ray is reported)
+    auto is_ray = [&]() {
+        double size = 0.0;
+        for(unsigned q=0; q<k; q++)
+            if(!bounded[q])
+                size = std::max(size, x[q]);
+        if(size == 0.0)
+            return false;
+        std::vector<double> direction(k, 0.0);
+        for(unsigned q=0; q<k; q++)
+            if(!bounded[q])
+                direction[q] = x[q]/size;
+        double value = dot(cost, direction);
+        return value < -BARRIER_TOL*(1 + c_norm) && norm_inf(A_times(direction)) <= -BARRIER_CERTIFICATE_TOL*value;
+    };
+
+    unsigned iteration = 0;
+    bool converged = false;
+    BarrierStatus verdict = BarrierStatus::FAILED;
+    out() << std::scientific << std::setprecision(2);
+    out() << "iteration | primal inf | dual inf | gap | mu" << std::endl;
+    for(; iteration<BARRIER_MAX_ITERATIONS; iteration++)
+    {
+        if(is_cancelled(cancel))
+            break;
+        counters().iterations++;
+        // Step1: residuals
+        // rb = b - Ax, rc = c - A^T*y - z + v, ru = u - x - w
+        // (rb is relative to size of b and of bounds, Ax ~ u also when b = 0)
+        auto Ax = A_times(x);
+        auto ATy = A_transposed_times(y);
+        std::vector<double> rb(m), rc(k), ru(k, 0.0);
+        for(unsigned i=0; i<m; i++)
+            rb[i] = rhs_b[i] - Ax[i];
+        for(unsigned q=0; q<k; q++)
+        {
+            rc[q] = cost[q] - ATy[q] - z[q] + v[q];
+            if(bounded[q])
+                ru[q] = u[q] - x[q] - w[q];
+        }
+        double mu = (dot(x, z) + dot(w, v))/(k + bounded_count);
+        double primal = dot(cost, x), dual = dot(rhs_b, y) - dot(u, v);
+        double primal_inf = std::max(norm_inf(rb)/(1 + std::max(b_norm, u_norm)), norm_inf(ru)/(1 + u_norm));
+        double dual_inf = norm_inf(rc)/(1 + c_norm);
+        double gap = std::fabs(primal - dual)/(1 + std::fabs(primal));
+        out() << iteration << " | " << primal_inf << " | " << dual_inf << " | " << gap << " | " << mu << std::endl;
+
+        if(primal_inf < BARRIER_TOL && dual_inf < BARRIER_TOL && gap < BARRIER_TOL)
+        {
+            converged = true;
+            break;
+        }
+        if(is_infeasible())
+        {
+            verdict = BarrierStatus::INFEASIBLE;
+            break;
+        }
+        if(is_ray())
+        {
+            verdict = (primal_inf < BARRIER_TOL) ? BarrierStatus::UNBOUNDED : BarrierStatus::INFEASIBLE_OR_UNBOUNDED;
+            break;
+        }
+        // Iterates diverge or complementarity vanishes without feasibility (ex. infeasible or unbounded
+        // system, but this is not proof of it, so method only fails)
+        if(!std::isfinite(mu) || mu < 1e-14*(1 + std::fabs(primal)) || norm_inf(x) > 1e12*(1 + b_norm + u_norm) ||
+           norm_inf(y) > 1e12*(1 + c_norm))
+            break;
+
+        // Step2: normal equations (A*D*A^T) dy = rb + A*D*r
+        // D = (Z/X + V/W)^-1 is diagonal, only lower triangle of A*D*A^T is formed
+        std::vector<double> d(k);
+        for(unsigned q=0; q<k; q++)
+            d[q] = 1.0/(z[q]/x[q] + (bounded[q] ? v[q]/w[q] : 0.0));
+        std::optional<Cholesky> cholesky;
+        try
+        {
+            cholesky.emplace(factorize(normal_matrix(d), threads));
+        }
+        catch(const std::invalid_argument&)
+        {
+            break;
+        }
+
+        // Newton direction for right side (rxz, rwv) of complementarity equations:
+        // Z*dx + X*dz = rxz, V*dw + W*dv = rwv
+        auto direction = [&](const std::vector<double>& rxz, const std::vector<double>& rwv) {
+            std::vector<double> r(k), Dr(k);
+            for(unsigned q=0; q<k; q++)
+            {
+                r[q] = rc[q] - rxz[q]/x[q];
+                if(bounded[q])
+                    r[q] += (rwv[q] - v[q]*ru[q])/w[q];
+                Dr[q] = d[q]*r[q];
+            }
+            auto ADr = A_times(Dr);
+            for(unsigned i=0; i<m; i++)
+                ADr[i] += rb[i];
+            auto dy = solve_normal(*cholesky, ADr);
+
+            auto ATdy = A_transposed_times(dy);
+            std::vector<double> dx(k), dz(k), dw(k, 0.0), dv(k, 0.0);
+            for(unsigned q=0; q<k; q++)
+            {
+                dx[q] = d[q]*(ATdy[q] - r[q]);
+                dz[q] = (rxz[q] - z[q]*dx[q])/x[q];
+                if(bounded[q])
+                {
+                    dw[q] = ru[q] - dx[q];
+                    dv[q] = (rwv[q] - v[q]*dw[q])/w[q];
+                }
+            }
+            return std::make_tuple(dx, dy, dz, dw, dv);
+        };
+
+        // Step3: predictor (affine direction, sigma = 0)
+        std::vector<double> rxz(k), rwv(k, 0.0);
+        for(unsigned q=0; q<k; q++)
+        {
+            rxz[q] = -x[q]*z[q];
+            if(bounded[q])
+                rwv[q] = -w[q]*v[q];
+        }
+        auto[dx_aff, dy_aff, dz_aff, dw_aff, dv_aff] = direction(rxz, rwv);
+        double alpha_p = std::min(max_step(x, dx_aff, all), max_step(w, dw_aff, bounded));
+        double alpha_d = std::min(max_step(z, dz_aff, all), max_step(v, dv_aff, bounded));
+        double mu_aff = 0.0;
+        for(unsigned q=0; q<k; q++)
+        {
+            mu_aff += (x[q] + alpha_p*dx_aff[q])*(z[q] + alpha_d*dz_aff[q]);
+            if(bounded[q])
+                mu_aff += (w[q] + alpha_p*dw_aff[q])*(v[q] + alpha_d*dv_aff[q]);
+        }
+        mu_aff /= (k + bounded_count);
+
+        // Step4: corrector with centering sigma = (mu_aff/mu)^3
+        double sigma = std::pow(mu_aff/mu, 3);
+        for(unsigned q=0; q<k; q++)
+        {
+            rxz[q] = -x[q]*z[q] - dx_aff[q]*dz_aff[q] + sigma*mu;
+            if(bounded[q])
+                rwv[q] = -w[q]*v[q] - dw_aff[q]*dv_aff[q] + sigma*mu;
+        }
+        auto[dx, dy, dz, dw, dv] = direction(rxz, rwv);
+
+        // Step5: step (separate primal and dual step length)
+        alpha_p = std::min(1.0, BARRIER_STEP*std::min(max_step(x, dx, all), max_step(w, dw, bounded)));
+        alpha_d = std::min(1.0, BARRIER_STEP*std::min(max_step(z, dz, all), max_step(v, dv, bounded)));
+        for(unsigned q=0; q<k; q++)
+        {
+            x[q] += alpha_p*dx[q];
+            z[q] += alpha_d*dz[q];
+            if(bounded[q])
+            {
+                w[q] += alpha_p*dw[q];
+                v[q] += alpha_d*dv[q];
+            }
+        }
+        for(unsigned i=0; i<m; i++)
+            y[i] += alpha_d*dy[i];
+    }
+    out() << std::fixed << std::setprecision(2);
+    out() << BAR << std::endl;
+    out() << "Number of iterations: " << iteration << std::endl;
+
+    if(!converged)
+    {
+        if(verdict == BarrierStatus::INFEASIBLE)
+            out() << "Direction of y is Farkas certificate => system has no solution!" << std::endl;
+        else if(verdict == BarrierStatus::UNBOUNDED)
+            out() << "x is feasible and grows on ray on which c*x decreases => function does not reach optimal value!" << std::endl;
+        else if(verdict == BarrierStatus::INFEASIBLE_OR_UNBOUNDED)
+            out() << "x grows on ray on which c*x decreases => system is infeasible or unbounded!" << std::endl;
+        else
+            out() << "Barrier did not converge (iterates diverge or system is singular)!" << std::endl;
+        if(status != nullptr)
+            *status = verdict;
+        return std::make_pair(0, Matrix());
+    }
+    if(status != nullptr)
+        *status = BarrierStatus::OPTIMAL;
+
+    Matrix result(1, N);
+    for(unsigned q=0; q<k; q++)
+        result.at(0, J[q]) = x[q];
+    double F = 0.0;
+    for(unsigned j=0; j<c.width(); j++)
+        F += c.at(0, j)*result.at(0, j);
+    return std::make_pair(F, result);
+}
+
+std::pair<std::vector<unsigned>, std::vector<unsigned> >
+crossover_basis(const Matrix& A, const Matrix& x, const Matrix& upper, std::vector<bool>& at_upper)
+{
+    auto m = A.height();
+    auto N = A.width() + m;
+
+    // Step1: nonbase variables go to nearest bound, distance from it decides order of columns
+    std::vector<double> distance(N);
+    std::vector<unsigned> order(N);
+    at_upper.assign(N, false);
+    for(unsigned j=0; j<N; j++)
+    {
+        order[j] = j;
+        double to_upper = upper.at(0, j) - x.at(0, j);
+        distance[j] = std::min(x.at(0, j), to_upper);
+        at_upper[j] = upper.at(0, j) < INF && to_upper < x.at(0, j);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](unsigned i, unsigned j) {
+        return distance[i] > distance[j];
+    });
+
+    // Step2: column enters base if it is linearly independent of columns already in base
+    // (Gram-Schmidt, base is always completed because every logical column is unit vector)
+    std::vector<unsigned> P;
+    std::vector<std::vector<double> > basis;
+    for(auto j: order)
+    {
+        if(P.size() == m)
+            break;
+        std::vector<double> K(m, 0.0);
+        for(auto[i, a]: sparse_column(A, j))
+            K[i] = a;
+        double norm = std::sqrt(dot(K, K));
+        if(norm == 0.0)
+            continue;
+        for(unsigned pass=0; pass<2; pass++)
+            for(auto& q: basis)
+            {
+                double projection = dot(q, K);
+                for(unsigned i=0; i<m; i++)
+                    K[i] -= projection*q[i];
+            }
+        double rest = std::sqrt(dot(K, K));
+        if(rest <= 1e-6*norm)
+            continue;
+        for(auto& value: K)
+            value /= rest;
+        basis.push_back(K);
+        P.push_back(j);
+        at_upper[j] = false;
+    }
+
+    return std::make_pair(P, get_Q(P, N));
+}
@@ -0,0 +1,37 @@
+#ifndef __BARRIER__
+#define __BARRIER__
+
+#include "simplex.hpp"
+
+// *INTERIOR POINT METHOD* (Mehrotra predictor-corrector) for system Ax + s = b, 0 <= x <= u, 0 <= s <= u, (min) c*x
+// Columns with u = 0 (ex. logical variables of equations) are fixed to 0 and left out
+
+// precision: relative primal/dual infeasibility and relative gap
+#define BARRIER_TOL 1e-8
+// precision of certificates (Farkas y and ray of x), relative to b*y and c*x on them
+#define BARRIER_CERTIFICATE_TOL 1e-6
+#define BARRIER_MAX_ITERATIONS 200
+// step is shortened to BARRIER_STEP * (max step) so iterates stay in interior
+#define BARRIER_STEP 0.995
+// smallest relative shift of starting point (starting point with x*z ~ 0 would stall at start)
+#define BARRIER_MIN_SHIFT 0.1
+
+// Verdict of barrier: OPTIMAL (iterates converged), INFEASIBLE (dual iterate y is Farkas certificate),
+// UNBOUNDED (primal iterate is feasible and its growing part is ray on which c*x decreases),
+// INFEASIBLE_OR_UNBOUNDED (ray, but primal iterate is not feasible: dual system has no solution),
+// FAILED (no convergence and no certificate, ex. iteration limit, singular system or cancel)
+// Certificates are checked in every iteration, so barrier stops as soon as iterates show them
+enum class BarrierStatus { OPTIMAL, INFEASIBLE, UNBOUNDED, INFEASIBLE_OR_UNBOUNDED, FAILED };
+
+// Returns (F, x) with x of width N+M (empty x if method did not converge), status ~ verdict (if given)
+// threads ~ number of threads used for Cholesky factorization of A*D*A^T (0 ~ all cores)
+std::pair<double, Matrix> barrier(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper,
+                                  unsigned threads, const std::atomic<bool>* cancel = nullptr,
+                                  BarrierStatus* status = nullptr);
+
+// Crossover: from interior solution x finds base P (nonbase variables go to nearest bound)
+// Variables furthest from their bounds are taken in base first, base is completed with logical columns
+std::pair<std::vector<unsigned>, std::vector<unsigned> >
+crossover_basis(const Matrix& A, const Matrix& x, const Matrix& upper, std::vector<bool>& at_upper);
+
+#endif
@@ -0,0 +1,187 @@
+#include "concurrent.hpp"
+
+EngineResult primal_engine(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper,
+                           const std::atomic<bool>* cancel)
+{
+    EngineResult result;
+    result.name = "primal";
+    std::tie(result.P, result.Q) = crash_basis(A, b, upper, result.at_upper);
+    // crash base that is not repaired => phase one of two-phase simplex (P is empty if system is infeasible)
+    if(result.P.empty())
+    {
+        result.at_upper.assign(A.width() + A.height(), false);
+        std::tie(result.F, result.x) = two_phase_simplex(A, b, c, result.P, result.Q, upper, result.at_upper, cancel);
+        result.optimal = result.x.width() != 0;
+        result.unbounded = !result.optimal && !result.P.empty() && !is_cancelled(cancel);
+        result.infeasible = !result.optimal && result.P.empty() && !is_cancelled(cancel);
+        return result;
+    }
+
+    std::tie(result.F, result.x) = residual_simplex(A, b, c, result.P, result.Q, upper, result.at_upper, cancel);
+    result.optimal = result.x.width() != 0;
+    result.unbounded = !result.optimal && !is_cancelled(cancel);
+    return result;
+}
+
+EngineResult dual_engine(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper,
+                         const std::atomic<bool>* cancel)
+{
+    EngineResult result;
+    result.name = "dual";
+    auto n = A.width();
+    auto m = A.height();
+
+    // Step1: slack base (B = E) => u = 0 and r(j) = c(j)
+    for(unsigned i=0; i<m; i++)
+        result.P.push_back(n+i);
+    result.Q = get_Q(result.P, n+m);
+    result.at_upper.assign(n+m, false);
+
+    // Step2: dual feasibility: variables with r(j) < 0 go to upper bound,
+    // if there is no upper bound then artificial one is used
+    Matrix bounded = upper;
+    std::vector<unsigned> artificial;
+    for(unsigned j=0; j<n; j++)
+        if(c.at(0, j) < -EPS)
+        {
+            result.at_upper.at(j) = true;
+            if(upper.at(0, j) == INF)
+            {
+                bounded.at(0, j) = ARTIFICIAL_BOUND;
+                artificial.push_back(j);
+            }
+        }
+    out() << "Slack base, " << artificial.size() << " artificial bounds" << std::endl;
+
+    // Dual simplex without result ~ some base variable can't reach its bound (system is infeasible),
+    // this is proof only if no variable is left at artificial bound (it could still increase)
+    std::tie(result.F, result.x) = dual_simplex(A, b, c, result.P, result.Q, bounded, result.at_upper, cancel);
+    if(result.x.width() == 0)
+    {
+        result.infeasible = !is_cancelled(cancel) &&
+            std::none_of(artificial.begin(), artificial.end(), [&](unsigned j) { return result.at_upper.at(j); });
+        return result;
+    }
+
+    // Step3: solution is optimal if no variable stays at artificial bound, otherwise x is feasible
+    // for real bounds too (artificial bounds only cut system), so every variable at artificial bound
+    // leaves it with primal ratio test on real bounds (only base variables can block it):
+    // r(j) < 0 => x(j) increases, if nothing blocks it then c*x decreases without bound on
+    // feasible ray (system is unbounded), otherwise x(j) decreases towards 0 (r(j) = 0)
+    // x(j) enters base where base variable blocks it or goes to 0 (bound flip), so base stays
+    // primal feasible and residual simplex continues from it with real bounds
+    bool restored = false;
+    for(auto j: artificial)
+    {
+        if(!result.at_upper.at(j))
+        {
+            bounded.at(0, j) = INF;
+            continue;
+        }
+        restored = true;
+        auto x = get_x(A, b, result.P, result.Q, bounded, result.at_upper);
+        LU B(get_B(A, result.P));
+        auto u = B.solve_transposed(get_Cb(c, result.P));
+        double r = get_cost(c, j) - dot_column(A, u, j);
+        auto y = B.solve(get_column(A, j)).transpose();
+        double direction = (r < -EPS) ? 1.0 : -1.0;
+        Matrix limits = upper;
+        limits.at(0, j) = (direction > 0) ? INF : ARTIFICIAL_BOUND;
+        auto[t_opt, t_index, to_upper] = get_t_opt(x, y, result.P, limits, j, direction);
+        if(t_index == STOP)
+        {
+            out() << "Artificial bound is reached and x" << j << " improves c*x without bound => "
+                  << "function does not reach optimal value!" << std::endl;
+            result.unbounded = true;
+            return result;
+        }
+        bounded.at(0, j) = INF;
+        result.at_upper.at(j) = false;
+        if(t_index == j)
+            out() << "Artificial bound of x" << j << " is removed, x" << j << " goes to 0" << std::endl;
+        else
+        {
+            out() << "Artificial bound of x" << j << " is removed, x" << j << " enters base (P) and x"
+                  << t_index << " leaves it" << std::endl;
+            update_P_Q(result.P, result.Q, t_index, j);
+            result.at_upper.at(t_index) = to_upper;
+        }
+    }
+    if(restored)
+    {
+        out() << "Artificial bounds are removed, continuing with real bounds:" << std::endl;
+        std::tie(result.F, result.x) = residual_simplex(A, b, c, result.P, result.Q, upper, result.at_upper, cancel);
+        result.optimal = result.x.width() != 0;
+        result.unbounded = !result.optimal && !is_cancelled(cancel);
+        return result;
+    }
+    result.optimal = true;
+    return result;
+}
+
+EngineResult barrier_engine(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper,
+                            unsigned threads, bool crossover, const std::atomic<bool>* cancel)
+{
+    EngineResult result;
+    result.name = crossover ? "barrier + crossover" : "barrier";
+    BarrierStatus verdict = BarrierStatus::FAILED;
+    std::tie(result.F, result.x) = barrier(A, b, c, upper, threads, cancel, &verdict);
+    if(result.x.width() == 0)
+    {
+        result.infeasible = verdict == BarrierStatus::INFEASIBLE;
+        result.unbounded = verdict == BarrierStatus::UNBOUNDED;
+        return result;
+    }
+
+    if(crossover)
+    {
+        std::tie(result.P, result.Q) = crossover_basis(A, result.x, upper, result.at_upper);
+        result.optimal = solve_from_basis(A, b, c, result.P, result.Q, upper, result.at_upper,
+                                          result.F, result.x, cancel) && result.x.width() != 0;
+        return result;
+    }
+    result.optimal = true;
+    return result;
+}
+
+std::pair<unsigned, std::vector<EngineResult> >
+concurrent_solve(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper,
+                 unsigned threads, bool crossover)
+{
+    std::vector<std::function<EngineResult(const std::atomic<bool>*)> > engines = {
+        [&](const std::atomic<bool>* cancel) { return primal_engine(A, b, c, upper, cancel); },
+        [&](const std::atomic<bool>* cancel) { return dual_engine(A, b, c, upper, cancel); },
+        [&](const std::atomic<bool>* cancel) { return barrier_engine(A, b, c, upper, threads, crossover, cancel); }
+    };
+
+    std::atomic<bool> cancel(false);
+    std::atomic<unsigned> winner(STOP);
+    std::vector<EngineResult> results(engines.size());
+    std::vector<std::thread> pool;
+    for(unsigned k=0; k<engines.size(); k++)
+        pool.emplace_back([&, k]() {
+            auto start = std::chrono::steady_clock::now();
+            std::ostringstream log;
+            log << std::fixed << std::setprecision(2);
+            set_output(log);
+
+            auto before = counters();
+            EngineResult result = engines[k](&cancel);
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            result.counters = counters() - before;
+            result.log = log.str();
+
+            // first engine with verdict (optimal, infeasible or unbounded) wins and cancels others
+            unsigned expected = STOP;
+            bool decided = result.optimal || result.infeasible || result.unbounded;
+            if(decided && winner.compare_exchange_strong(expected, k))
+                cancel = true;
+            else if(!decided)
+                result.cancelled = cancel.load();
+            results[k] = std::move(result);
+        });
+    for(auto& thread: pool)
+        thread.join();
+
+    return std::make_pair(winner.load(), std::move(results));
+}
@@ -0,0 +1,53 @@
+#ifndef __CONCURRENT__
+#define __CONCURRENT__
+
+#include "barrier.hpp"
+#include <sstream>
+#include <thread>
+#include <chrono>
+
+// *CONCURRENT SOLVE*
+// Primal simplex, dual simplex and barrier are started in parallel threads on same system
+// (A, b, c and upper are only read, every engine has its own base and solution).
+// First engine that finds optimal solution (or proves that system is infeasible or unbounded) sets
+// cancel flag and other engines stop at their next iteration.
+
+// Artificial upper bound used by dual engine for variables with c(j) < 0 and u(j) = inf
+#define ARTIFICIAL_BOUND 1e6
+
+struct EngineResult {
+    std::string name;
+    // unbounded ~ engine found ray of feasible solutions on which c*x decreases without bound
+    // infeasible ~ engine proved that system has no feasible solution (phase one, dual simplex or
+    // Farkas certificate of barrier)
+    bool optimal = false, cancelled = false, unbounded = false, infeasible = false;
+    double F = 0.0, seconds = 0.0;
+    Matrix x;
+    std::vector<unsigned> P, Q;
+    std::vector<bool> at_upper;
+    // work done by engine (counters of its thread)
+    SimplexCounters counters;
+    // output of engine (written to std::ostringstream, so threads do not mix output)
+    std::string log;
+};
+
+// Primal: crash base + residual simplex (two-phase simplex if crash base is not repaired)
+EngineResult primal_engine(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper,
+                           const std::atomic<bool>* cancel);
+
+// Dual: slack base + dual simplex (base is made dual feasible with variables at upper bounds),
+// variables left at artificial bounds are moved with primal ratio test (unbounded if nothing blocks)
+EngineResult dual_engine(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper,
+                         const std::atomic<bool>* cancel);
+
+// Barrier (+ crossover to simplex base)
+EngineResult barrier_engine(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper,
+                            unsigned threads, bool crossover, const std::atomic<bool>* cancel);
+
+// Returns index of winner (STOP if no engine found optimal solution, infeasibility or unboundedness)
+// and results of all engines
+std::pair<unsigned, std::vector<EngineResult> >
+concurrent_solve(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper,
+                 unsigned threads, bool crossover);
+
+#endif
@@ -0,0 +1,524 @@
+#include "cuts.hpp"
+
+std::string to_string(CutFamily family)
+{
+    switch(family)
+    {
+        case CutFamily::GOMORY: return "gomory";
+        case CutFamily::GMI: return "gmi";
+        case CutFamily::MIR: return "mir";
+        case CutFamily::COVER: return "cover";
+    }
+    return "";
+}
+
+double norm(const std::vector<double>& a)
+{
+    double sum = 0.0;
+    for(auto value: a)
+        sum += value*value;
+    return std::sqrt(sum);
+}
+
+double efficacy(const Cut& cut, const std::vector<double>& x)
+{
+    double ax = 0.0;
+    for(unsigned j=0; j<x.size(); j++)
+        ax += cut.a.at(j)*x.at(j);
+    return (cut.rhs - ax)/norm(cut.a);
+}
+
+double parallelism(const Cut& first, const Cut& second)
+{
+    double product = 0.0;
+    for(unsigned j=0; j<first.a.size(); j++)
+        product += first.a.at(j)*second.a.at(j);
+    return std::fabs(product)/(norm(first.a)*norm(second.a));
+}
+
+bool is_duplicate(const Cut& first, const Cut& second)
+{
+    double product = 0.0;
+    for(unsigned j=0; j<first.a.size(); j++)
+        product += first.a.at(j)*second.a.at(j);
+    double n1 = norm(first.a), n2 = norm(second.a);
+    return product > 0.0 && product/(n1*n2) > 1 - 1e-9 && std::fabs(first.rhs/n1 - second.rhs/n2) < 1e-9;
+}
+
+bool gomory_cut(const Matrix& row, double value, const std::vector<unsigned>& P,
+                const std::vector<std::vector<double> >& A, const std::vector<double>& b,
+                const std::vector<char>& sense, Cut& cut)
+{
+    unsigned n = row.width() - A.size();
+    std::vector<bool> is_base(row.width(), false);
+    for(auto p: P)
+        is_base.at(p) = true;
+
+    cut.a.assign(n, 0.0);
+    cut.rhs = phi(value);
+    cut.age = 0;
+    cut.family = CutFamily::GOMORY;
+    for(unsigned j=0; j<n; j++)
+        if(!is_base.at(j))
+            cut.a.at(j) = phi(row.at(0, j));
+    for(unsigned i=0; i<A.size(); i++)
+    {
+        double coef = phi(row.at(0, n+i));
+        if(is_base.at(n+i) || sense.at(i) == '=' || coef == 0.0)
+            continue;
+        double sign = (sense.at(i) == '<') ? -1.0 : 1.0;
+        for(unsigned j=0; j<n; j++)
+            cut.a.at(j) += coef*sign*A.at(i).at(j);
+        cut.rhs += coef*sign*b.at(i);
+    }
+
+    for(unsigned j=0; j<n; j++)
+        if(std::fabs(cut.a.at(j)) > EPS)
+            return true;
+    return false;
+}
+
+// value is integer up to 1e-9 (data of rows)
+static bool is_integral(double value)
+{
+    return std::fabs(value - std::round(value)) < 1e-9;
+}
+
+bool gmi_cut(const Matrix& row, double value, const std::vector<unsigned>& P, const std::vector<bool>& at_upper,
+             const LPModel& model, const std::vector<std::vector<double> >& A, const std::vector<double>& b,
+             const std::vector<char>& sense, Cut& cut)
+{
+    unsigned n = model.cols();
+    std::vector<bool> is_base(row.width(), false);
+    for(auto p: P)
+        is_base.at(p) = true;
+
+    double f0 = phi(value);
+    cut.a.assign(n, 0.0);
+    cut.rhs = 1.0;
+    cut.age = 0;
+    cut.family = CutFamily::GMI;
+    if(f0 == 0.0)
+        return false;
+
+    // coefficient of z(j) in cut for row coefficient a of z(j)
+    auto coefficient = [f0](double a, bool integer)
+    {
+        if(integer)
+        {
+            double f = phi(a);
+            return std::min(f/f0, (1 - f)/(1 - f0));
+        }
+        return (a > 0) ? a/f0 : -a/(1 - f0);
+    };
+
+    for(unsigned j=0; j<n; j++)
+    {
+        double a = row.at(0, j);
+        if(is_base.at(j) || std::fabs(a) < 1e-9)
+            continue;
+        // x'(j) = direction*(x(j) - offset), z = x' (at lower) or u' - x' (at upper)
+        double lower = model.lower.at(j), upper = model.upper.at(j);
+        double offset = std::isinf(lower) ? upper : lower, direction = std::isinf(lower) ? -1.0 : 1.0;
+        bool upper_side = at_upper.at(j);
+        double g = coefficient(upper_side ? -a : a, model.is_integer.at(j));
+        if(upper_side)
+        {
+            cut.a.at(j) -= g*direction;
+            cut.rhs -= g*(std::fabs(upper - lower) + direction*offset);
+        }
+        else
+        {
+            cut.a.at(j) += g*direction;
+            cut.rhs += g*direction*offset;
+        }
+    }
+
+    for(unsigned i=0; i<A.size(); i++)
+    {
+        double a = row.at(0, n+i);
+        if(is_base.at(n+i) || sense.at(i) == '=' || std::fabs(a) < 1e-9)
+            continue;
+        double range = (i < model.rows()) ? model.range.at(i) : LP_INF;
+        bool integer = is_integral(b.at(i)) && (std::isinf(range) || is_integral(range));
+        for(unsigned j=0; j<n && integer; j++)
+            integer = A.at(i).at(j) == 0.0 || (model.is_integer.at(j) && is_integral(A.at(i).at(j)));
+        bool upper_side = at_upper.at(n+i);
+        double g = coefficient(upper_side ? -a : a, integer);
+        // s = sign*(A(i)*x - b(i)), z = s (at lower) or range - s (at upper)
+        double sign = (sense.at(i) == '<') ? -1.0 : 1.0, direction = upper_side ? -sign : sign;
+        for(unsigned j=0; j<n; j++)
+            cut.a.at(j) += g*direction*A.at(i).at(j);
+        cut.rhs += g*direction*b.at(i);
+        if(upper_side)
+            cut.rhs -= g*range;
+    }
+
+    for(unsigned j=0; j<n; j++)
+        if(std::fabs(cut.a.at(j)) > EPS)
+            return true;
+    return false;
+}
+
+// Rows a*x <= beta of model (sparse): '<' row, '>' row multiplied by -1, equation and row with range
+// give both sides
+static std::vector<std::pair<std::vector<std::pair<unsigned, double> >, double> > knapsack_rows(const LPModel& model)
+{
+    std::vector<std::vector<std::pair<unsigned, double> > > rows(model.rows());
+    for(unsigned j=0; j<model.cols(); j++)
+        for(unsigned k=model.A.start(j); k<model.A.end(j); k++)
+            if(model.A.value(k) != 0.0)
+                rows.at(model.A.index(k)).push_back(std::make_pair(j, model.A.value(k)));
+
+    std::vector<std::pair<std::vector<std::pair<unsigned, double> >, double> > result;
+    for(unsigned i=0; i<model.rows(); i++)
+    {
+        auto negative = rows.at(i);
+        for(auto& [j, a]: negative)
+            a = -a;
+        double b = model.rhs.at(i), range = model.range.at(i);
+        char sense = model.sense.at(i);
+        // upper side: a*x <= b ('<', '='), a*x <= b + range ('>' with range)
+        if(sense != '>')
+            result.push_back(std::make_pair(rows.at(i), b));
+        else if(!std::isinf(range))
+            result.push_back(std::make_pair(rows.at(i), b + range));
+        // lower side: -a*x <= -b ('>', '='), -a*x <= -(b - range) ('<' with range)
+        if(sense != '<')
+            result.push_back(std::make_pair(negative, -b));
+        else if(!std::isinf(range))
+            result.push_back(std::make_pair(negative, range - b));
+    }
+    return result;
+}
+
+std::vector<Cut> mir_cuts(const LPModel& model, const std::vector<double>& x)
+{
+    std::vector<Cut> cuts;
+    for(const auto& [terms, rhs]: knapsack_rows(model))
+    {
+        // Step1: bound substitution, z(j) = x(j) - l(j) (complemented = false) or u(j) - x(j)
+        struct Term {
+            unsigned j;
+            double a, z;
+            bool complemented;
+        };
+        std::vector<Term> integers, continuous;
+        double beta = rhs;
+        bool valid = true, fractional = false;
+        for(const auto& [j, a]: terms)
+        {
+            double lower = model.lower.at(j), upper = model.upper.at(j);
+            if(std::isinf(lower) && std::isinf(upper))
+            {
+                valid = false;
+                break;
+            }
+            bool complemented = std::isinf(lower) || (!std::isinf(upper) && upper - x.at(j) < x.at(j) - lower);
+            Term term{j, complemented ? -a : a, complemented ? upper - x.at(j) : x.at(j) - lower, complemented};
+            beta -= a*(complemented ? upper : lower);
+            if(model.is_integer.at(j))
+            {
+                fractional = fractional || phi(x.at(j)) > 0.0;
+                integers.push_back(term);
+            }
+            else if(term.a < 0)
+                continuous.push_back(term);
+        }
+        if(!valid || !fractional)
+            continue;
+
+        // Step2: divisors
+        std::vector<double> divisors;
+        for(const auto& term: integers)
+        {
+            double upper = model.upper.at(term.j) - model.lower.at(term.j);
+            double delta = std::fabs(term.a);
+            if(term.z > EPS && term.z < upper - EPS && delta > 1e-9 && divisors.size() < MIR_MAX_DIVISORS &&
+               std::find(divisors.begin(), divisors.end(), delta) == divisors.end())
+                divisors.push_back(delta);
+        }
+
+        // Step3: MIR cut for every divisor, best efficacy (for z) wins
+        auto make = [&](double delta, Cut& cut)
+        {
+            double f = beta/delta - std::floor(beta/delta);
+            if(f < 1e-2 || f > 1 - 1e-2)
+                return -INF;
+            // cut in z: sum{g(j)*z(j)} - h*s <= floor(beta/delta)
+            cut.a.assign(model.cols(), 0.0);
+            cut.rhs = std::floor(beta/delta);
+            cut.age = 0;
+            cut.family = CutFamily::MIR;
+            double activity = 0.0, sum = 0.0;
+            auto add = [&](const Term& term, double g)
+            {
+                activity += g*term.z;
+                sum += g*g;
+                double lower = model.lower.at(term.j), upper = model.upper.at(term.j);
+                cut.a.at(term.j) += term.complemented ? -g : g;
+                cut.rhs += term.complemented ? -g*upper : g*lower;
+            };
+            for(const auto& term: integers)
+            {
+                double ratio = term.a/delta, fraction = ratio - std::floor(ratio);
+                add(term, std::floor(ratio) + std::max(0.0, fraction - f)/(1 - f));
+            }
+            for(const auto& term: continuous)
+                add(term, term.a/(delta*(1 - f)));
+            return (sum > 0.0) ? (activity - std::floor(beta/delta))/std::sqrt(sum) : -INF;
+        };
+        Cut best;
+        double best_efficacy = 0.0, best_delta = 0.0;
+        for(auto delta: divisors)
+        {
+            Cut cut;
+            double value = make(delta, cut);
+            if(value > best_efficacy)
+            {
+                best_efficacy = value;
+                best_delta = delta;
+                best = cut;
+            }
+        }
+        for(double divide: {2.0, 4.0, 8.0})
+        {
+            Cut cut;
+            double value = (best_delta > 0.0) ? make(best_delta/divide, cut) : -INF;
+            if(value > best_efficacy)
+            {
+                best_efficacy = value;
+                best = cut;
+            }
+        }
+        if(best_efficacy <= 0.0)
+            continue;
+        // a*x <= rhs => -a*x >= -rhs
+        for(auto& value: best.a)
+            value = -value;
+        best.rhs = -best.rhs;
+
+        // Step4: coefficient |a(j)| < MIR_MIN_COEFFICIENT is removed with bound of x(j):
+        // a(j)*x(j) <= max(a(j)*l(j), a(j)*u(j)), so rhs decreases by that value and cut stays valid
+        // (cut is dropped if that bound is infinite or no coefficient is left)
+        bool kept = true, empty = true;
+        for(unsigned j=0; j<model.cols(); j++)
+        {
+            double a = best.a.at(j);
+            if(a == 0.0 || std::fabs(a) >= MIR_MIN_COEFFICIENT)
+            {
+                empty = empty && a == 0.0;
+                continue;
+            }
+            double bound = (a > 0) ? model.upper.at(j) : model.lower.at(j);
+            if(std::isinf(bound))
+            {
+                kept = false;
+                break;
+            }
+            best.rhs -= a*bound;
+            best.a.at(j) = 0.0;
+        }
+        if(kept && !empty)
+            cuts.push_back(best);
+    }
+    return cuts;
+}
+
+std::vector<Cut> cover_cuts(const LPModel& model, const std::vector<double>& x)
+{
+    std::vector<Cut> cuts;
+    for(const auto& [terms, rhs]: knapsack_rows(model))
+    {
+        // Step1: knapsack sum{a(j)*z(j)} <= beta, a > 0, z binary
+        struct Item {
+            unsigned j;
+            double a, z;
+            bool complemented;
+        };
+        std::vector<Item> items;
+        double beta = rhs;
+        bool valid = true;
+        for(const auto& [j, a]: terms)
+        {
+            double lower = model.lower.at(j), upper = model.upper.at(j);
+            if(model.is_integer.at(j) && lower == 0.0 && upper == 1.0)
+            {
+                if(a < 0)
+                    beta -= a;
+                items.push_back(Item{j, std::fabs(a), (a < 0) ? 1 - x.at(j) : x.at(j), a < 0});
+            }
+            // a(j)*x(j) >= a(j)*l(j) for a(j) > 0, a(j)*u(j) for a(j) < 0
+            else if(!std::isinf(a > 0 ? lower : upper))
+                beta -= a*(a > 0 ? lower : upper);
+            else
+            {
+                valid = false;
+                break;
+            }
+        }
+        double total = 0.0;
+        for(const auto& item: items)
+            total += item.a;
+        if(!valid || items.size() < 2 || beta < 0.0 || total <= beta + 1e-9*std::max(1.0, std::fabs(beta)))
+            continue;
+
+        // Step2: cover by (1 - z(j))/a(j), then items are removed (largest 1 - z(j) first) while C stays cover
+        std::vector<unsigned> order(items.size());
+        for(unsigned k=0; k<order.size(); k++)
+            order.at(k) = k;
+        std::sort(order.begin(), order.end(), [&](unsigned first, unsigned second)
+        {
+            return (1 - items.at(first).z)*items.at(second).a < (1 - items.at(second).z)*items.at(first).a;
+        });
+        std::vector<bool> in_cover(items.size(), false);
+        std::vector<unsigned> cover;
+        double weight = 0.0;
+        for(auto k: order)
+        {
+            if(weight > beta + 1e-9*std::max(1.0, beta))
+                break;
+            in_cover.at(k) = true;
+            cover.push_back(k);
+            weight += items.at(k).a;
+        }
+        for(unsigned l=cover.size(); l-->0;)
+        {
+            unsigned k = cover.at(l);
+            if(weight - items.at(k).a > beta + 1e-9*std::max(1.0, beta))
+            {
+                weight -= items.at(k).a;
+                in_cover.at(k) = false;
+                cover.erase(cover.begin() + l);
+            }
+        }
+        double slack = 0.0;
+        for(auto k: cover)
+            slack += 1 - items.at(k).z;
+        if(cover.size() < 2 || slack >= 1 - EPS)
+            continue;
+
+        // Step3: sequential up-lifting: alpha(j) = |C| - 1 - max{profit | weight <= beta - a(j)} of items
+        // already in cut, lightest[v] ~ smallest weight of profit >= v
+        unsigned K = cover.size() - 1;
+        std::vector<double> lightest(K+1, INF), coefficients(items.size(), 0.0);
+        lightest.at(0) = 0.0;
+        auto insert = [&](double a, unsigned profit)
+        {
+            for(unsigned v=K+1; v-->1;)
+            {
+                double previous = lightest.at(v > profit ? v - profit : 0);
+                if(previous < INF)
+                    lightest.at(v) = std::min(lightest.at(v), previous + a);
+            }
+        };
+        for(auto k: cover)
+        {
+            coefficients.at(k) = 1.0;
+            insert(items.at(k).a, 1);
+        }
+        std::vector<unsigned> rest;
+        for(unsigned k=0; k<items.size(); k++)
+            if(!in_cover.at(k))
+                rest.push_back(k);
+        std::sort(rest.begin(), rest.end(), [&](unsigned first, unsigned second)
+        {
+            const auto& p = items.at(first);
+            const auto& q = items.at(second);
+            return (p.z != q.z) ? p.z > q.z : p.a > q.a;
+        });
+        for(auto k: rest)
+        {
+            double capacity = beta - items.at(k).a + 1e-9*std::max(1.0, beta);
+            unsigned profit = 0;
+            for(unsigned v=0; v<=K && capacity >= 0.0; v++)
+                if(lightest.at(v) <= capacity)
+                    profit = v;
+            unsigned alpha = (capacity < 0.0) ? K : K - profit;
+            if(alpha == 0)
+                continue;
+            coefficients.at(k) = alpha;
+            insert(items.at(k).a, alpha);
+        }
+
+        // Step4: sum{alpha(j)*z(j)} <= K for x, z = 1 - x for complemented variables => -a*x >= -rhs
+        Cut cut;
+        cut.a.assign(model.cols(), 0.0);
+        cut.rhs = -1.0*K;
+        cut.age = 0;
+        cut.family = CutFamily::COVER;
+        for(unsigned k=0; k<items.size(); k++)
+        {
+            double alpha = coefficients.at(k);
+            if(items.at(k).complemented)
+            {
+                cut.a.at(items.at(k).j) += alpha;
+                cut.rhs += alpha;
+            }
+            else
+                cut.a.at(items.at(k).j) -= alpha;
+        }
+        cuts.push_back(cut);
+    }
+    return cuts;
+}
+
+void filter_cuts(std::vector<Cut>& candidates, const std::vector<double>& x)
+{
+    for(unsigned k=candidates.size(); k-->0;)
+    {
+        const auto& cut = candidates.at(k);
+        double ax = 0.0, largest = 0.0, smallest = INF;
+        for(unsigned j=0; j<x.size(); j++)
+        {
+            double a = std::fabs(cut.a.at(j));
+            ax += cut.a.at(j)*x.at(j);
+            if(a > 0.0)
+            {
+                largest = std::max(largest, a);
+                smallest = std::min(smallest, a);
+            }
+        }
+        bool weak = cut.rhs - ax <= MIN_VIOLATION*std::max(1.0, std::fabs(cut.rhs)) || largest == 0.0 ||
+                    efficacy(cut, x) <= MIN_EFFICACY || largest > MAX_DYNAMISM*smallest;
+        if(weak)
+            candidates.erase(candidates.begin() + k);
+    }
+}
+
+std::vector<unsigned> select_cuts(const std::vector<Cut>& candidates, const std::vector<double>& x,
+                                  const std::vector<Cut>& active, unsigned max_cuts,
+                                  std::vector<unsigned>* rejected)
+{
+    std::vector<std::pair<double, unsigned> > order;
+    for(unsigned k=0; k<candidates.size(); k++)
+        order.push_back(std::make_pair(-efficacy(candidates.at(k), x), k));
+    std::sort(order.begin(), order.end());
+
+    std::vector<unsigned> chosen;
+    for(const auto& [negative_efficacy, k]: order)
+    {
+        const auto& cut = candidates.at(k);
+        bool duplicate = false, parallel = false;
+        for(const auto& other: active)
+        {
+            duplicate = duplicate || is_duplicate(cut, other);
+            parallel = parallel || parallelism(cut, other) > MAX_PARALLELISM;
+        }
+        for(auto l: chosen)
+        {
+            duplicate = duplicate || is_duplicate(cut, candidates.at(l));
+            parallel = parallel || parallelism(cut, candidates.at(l)) > MAX_PARALLELISM;
+        }
+        // best cut is always added (unless it is already in system), others only if they
+        // cut x off and are not almost parallel to other cuts
+        if(duplicate || (!chosen.empty() && (parallel || -negative_efficacy <= EPS || chosen.size() >= max_cuts)))
+        {
+            if(!duplicate && rejected)
+                rejected->push_back(k);
+            continue;
+        }
+        chosen.push_back(k);
+    }
+    return chosen;
+}
\ No newline at end of file
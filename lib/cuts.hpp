@@ -0,0 +1,120 @@
+#ifndef __CUTS__
+#define __CUTS__
+
+#include "lp_solver.hpp"
+
+// *CUTTING PLANES* (liblp)
+// Cuts are written for original variables: a*x >= rhs
+// Families: GOMORY ~ fractional Gomory's cut (pure integer problems with x >= 0 and integer data),
+// GMI ~ Gomory's mixed integer cut from tableau row, MIR ~ mixed integer rounding of original row,
+// COVER ~ lifted knapsack cover of original row (binary variables)
+// GMI, MIR and COVER are valid for mixed problems with bounds of LPModel (cuts of root)
+
+// cuts added in one round: best by efficacy that are not almost parallel to cuts already chosen
+#define CUTS_PER_ROUND 5
+// cut whose |cos| of angle with chosen or active cut is above MAX_PARALLELISM is not added
+#define MAX_PARALLELISM 0.95
+// candidate is dropped if it cuts x off by less than MIN_VIOLATION*max(1, |rhs|) or by distance
+// less than MIN_EFFICACY, or if ratio of its largest and smallest |a(j)| > 0 is above MAX_DYNAMISM
+#define MIN_VIOLATION 1e-6
+#define MIN_EFFICACY 1e-4
+#define MAX_DYNAMISM 1e6
+// MIR tries divisors |a(j)| of integer variables strictly between bounds (at most MIR_MAX_DIVISORS),
+// and best divisor divided by 2, 4 and 8
+#define MIR_MAX_DIVISORS 8
+// coefficient of MIR cut with |a(j)| below MIR_MIN_COEFFICIENT (close to precision of simplex) is
+// removed with bound of x(j), tiny coefficients make LP of cut wrong by more than precision
+#define MIR_MIN_COEFFICIENT (10*EPS)
+
+enum class CutFamily { GOMORY, GMI, MIR, COVER };
+
+std::string to_string(CutFamily family);
+
+// fractional part: phi(value) = value - floor(value) (phi(-0.25) = 0.75), values close to integer have phi = 0
+inline double phi(double value)
+{
+    double fraction = value - std::floor(value);
+    return (fraction < EPS || fraction > 1 - EPS) ? 0.0 : fraction;
+}
+
+// Cut: a*x >= rhs (original variables)
+// age ~ rounds in a row in which cut was not tight (active cut) or not violated (cut of pool)
+struct Cut {
+    std::vector<double> a;
+    double rhs;
+    unsigned age;
+    CutFamily family = CutFamily::GOMORY;
+};
+
+// work of one cut family: separation rounds, candidates, candidates left after filter_cuts, cuts
+// added to relaxation, improvement of bound (min sign*c*x) after its cuts were added, time
+struct CutStats {
+    CutFamily family;
+    unsigned long rounds = 0, candidates = 0, filtered = 0, added = 0;
+    double gain = 0.0, seconds = 0.0;
+};
+
+double norm(const std::vector<double>& a);
+
+// efficacy ~ distance of x from hyperplane of cut: (rhs - a*x)/||a|| (> 0 if cut removes x)
+double efficacy(const Cut& cut, const std::vector<double>& x);
+
+// parallelism ~ |cos| of angle between cuts: |a1*a2|/(||a1||*||a2||)
+double parallelism(const Cut& first, const Cut& second);
+
+// same hyperplane and same side (a and rhs differ only by positive factor, relative precision 1e-9:
+// cuts of later rounds have large coefficients and cut x off by very small distance)
+bool is_duplicate(const Cut& first, const Cut& second);
+
+// Gomory's cut from row of optimal tableau (row = B'[A | E], value = x of base variable in that row)
+// of system A(i)*x sense(i) b(i), x >= 0 and integer (A and b integer, rows A, b and sense are rows
+// of Solver, logical column of row i is N+i):
+// sum{phi(row(j))*x(j) | j not in base} >= phi(value)
+// Logical variable of row i is s(i) = b(i) - A(i)*x for '<' and s(i) = A(i)*x - b(i) for '>'
+// (integer if A and b are integer), so it is replaced with x to get cut for original variables
+// Returns false if cut has no non-zero coefficients (there is no integer solution)
+bool gomory_cut(const Matrix& row, double value, const std::vector<unsigned>& P,
+                const std::vector<std::vector<double> >& A, const std::vector<double>& b,
+                const std::vector<char>& sense, Cut& cut);
+
+// Gomory's mixed integer cut from row of optimal tableau (row = B'[A | E], value = value of integer
+// base variable in system, P and at_upper ~ optimal base of Solver loaded with model), rows A, b and
+// sense are rows of Solver (rows of model and added rows, added rows have no range)
+// Variable of system is z(j) = x'(j) at lower bound or u'(j) - x'(j) at upper bound (x(j) = offset(j)
+// + direction(j)*x'(j), offset ~ lower bound or upper bound if there is no lower bound), so row is
+// x(B) + sum{a(j)*z(j)} = value, z >= 0 and cut with f0 = phi(value), f(j) = phi(a(j)) is
+// sum{min(f(j)/f0, (1 - f(j))/(1 - f0))*z(j) | z(j) integer} + sum{a(j)/f0*z(j) | a(j) > 0, z(j) continuous}
+//   + sum{-a(j)/(1 - f0)*z(j) | a(j) < 0, z(j) continuous} >= 1
+// Logical variable is integer if its row has only integer variables and A(i), b(i) and range are integer
+// Every variable needs finite bound (no free variables), returns false if cut has no non-zero coefficients
+bool gmi_cut(const Matrix& row, double value, const std::vector<unsigned>& P, const std::vector<bool>& at_upper,
+             const LPModel& model, const std::vector<std::vector<double> >& A, const std::vector<double>& b,
+             const std::vector<char>& sense, Cut& cut);
+
+// MIR cuts of rows of model (row with range or equation gives two rows a*x <= beta)
+// Variables are moved to bounds closest to x (integer x = l + z or x = u - z, continuous too), continuous
+// variables with positive coefficient are dropped, others give s >= 0, then row sum{a(j)*z(j)} - s <= beta
+// is divided by delta (f = phi(beta/delta)):
+// sum{(floor(a(j)/delta) + max(0, phi(a(j)/delta) - f)/(1 - f))*z(j)} - s/(delta*(1 - f)) <= floor(beta/delta)
+// One cut (best efficacy for x) of every row, rows with free variables are skipped
+std::vector<Cut> mir_cuts(const LPModel& model, const std::vector<double>& x);
+
+// Lifted cover cuts of knapsack rows: binary variables with a(j) < 0 are complemented (z = 1 - x), other
+// variables are replaced with their bound (row is relaxed), so row is sum{a(j)*z(j)} <= beta, a > 0
+// Cover C (sum{a(j) | j in C} > beta) is chosen greedily by (1 - z(j))/a(j) and made minimal, cover
+// sum{z(j) | j in C} <= |C| - 1 is lifted (sequential up-lifting, exact with dynamic programming on
+// profits 0..|C| - 1) for variables out of cover, one cut of every row that x violates
+std::vector<Cut> cover_cuts(const LPModel& model, const std::vector<double>& x);
+
+// Candidates that don't pass violation, efficacy and dynamism limits are removed
+void filter_cuts(std::vector<Cut>& candidates, const std::vector<double>& x);
+
+// Candidates are sorted by efficacy, duplicates of active cuts and of other candidates are dropped,
+// cut is chosen if it is not almost parallel (MAX_PARALLELISM) to chosen and active cuts and cuts x off,
+// best cut is always chosen (unless it is already in system), at most max_cuts cuts are chosen
+// Returns indexes of chosen candidates (best first), rejected gets other candidates that are not duplicates
+std::vector<unsigned> select_cuts(const std::vector<Cut>& candidates, const std::vector<double>& x,
+                                  const std::vector<Cut>& active, unsigned max_cuts,
+                                  std::vector<unsigned>* rejected = nullptr);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,288 @@
+#include "mip.hpp"
+
+bool is_feasible(const LPModel& model, const std::vector<double>& x)
+{
+    std::vector<double> activity(model.rows(), 0.0);
+    for(unsigned j=0; j<model.cols(); j++)
+    {
+        if(x.at(j) < model.lower.at(j) - EPS || x.at(j) > model.upper.at(j) + EPS)
+            return false;
+        if(model.is_integer.at(j) && phi(x.at(j)) != 0.0)
+            return false;
+        for(unsigned k=model.A.start(j); k<model.A.end(j); k++)
+            activity.at(model.A.index(k)) += model.A.value(k)*x.at(j);
+    }
+    for(unsigned i=0; i<model.rows(); i++)
+    {
+        double b = model.rhs.at(i), range = model.range.at(i), tolerance = EPS*std::max(1.0, std::fabs(b));
+        double low = -LP_INF, high = LP_INF;
+        if(model.sense.at(i) == '<')
+        {
+            high = b;
+            low = b - range;
+        }
+        else if(model.sense.at(i) == '>')
+        {
+            low = b;
+            high = b + range;
+        }
+        else
+            low = high = b;
+        if(activity.at(i) < low - tolerance || activity.at(i) > high + tolerance)
+            return false;
+    }
+    return true;
+}
+
+double objective_value(const LPModel& model, const std::vector<double>& x)
+{
+    double F = model.c0;
+    for(unsigned j=0; j<model.cols(); j++)
+        F += model.c.at(j)*x.at(j);
+    return F;
+}
+
+// integer variables of LP solution are rounded (they are integral up to EPS)
+static void round_integers(const LPModel& model, std::vector<double>& x)
+{
+    for(unsigned j=0; j<model.cols(); j++)
+        if(model.is_integer.at(j))
+            x.at(j) = std::round(x.at(j));
+}
+
+bool simple_rounding(const LPModel& model, const std::vector<double>& x, std::vector<double>& solution)
+{
+    solution = x;
+    for(unsigned j=0; j<model.cols(); j++)
+    {
+        if(!model.is_integer.at(j) || phi(x.at(j)) == 0.0)
+            continue;
+        // Step1: locks of x(j) from rows of column j
+        bool down_lock = false, up_lock = false;
+        for(unsigned k=model.A.start(j); k<model.A.end(j); k++)
+        {
+            unsigned i = model.A.index(k);
+            double a = model.A.value(k);
+            if(a == 0.0)
+                continue;
+            if(model.sense.at(i) == '=' || !std::isinf(model.range.at(i)))
+                down_lock = up_lock = true;
+            else if((model.sense.at(i) == '<') == (a > 0))
+                up_lock = true;
+            else
+                down_lock = true;
+        }
+        // Step2: round in direction without lock
+        if(!down_lock)
+            solution.at(j) = std::floor(x.at(j));
+        else if(!up_lock)
+            solution.at(j) = std::ceil(x.at(j));
+        else
+            return false;
+    }
+    round_integers(model, solution);
+    return is_feasible(model, solution);
+}
+
+bool rens(const LPModel& model, const std::vector<double>& x, const std::vector<double>& lower,
+          const std::vector<double>& upper, std::vector<double>& solution)
+{
+    LPModel sub = model;
+    unsigned integers = 0, fixed = 0;
+    for(unsigned j=0; j<model.cols(); j++)
+    {
+        sub.lower.at(j) = lower.at(j);
+        sub.upper.at(j) = upper.at(j);
+        if(!model.is_integer.at(j))
+            continue;
+        integers++;
+        if(phi(x.at(j)) == 0.0)
+        {
+            fixed++;
+            sub.lower.at(j) = sub.upper.at(j) = std::round(x.at(j));
+        }
+        else
+        {
+            sub.lower.at(j) = std::max(lower.at(j), std::floor(x.at(j)));
+            sub.upper.at(j) = std::min(upper.at(j), std::ceil(x.at(j)));
+        }
+    }
+    if(fixed < RENS_MIN_FIXED*integers)
+        return false;
+
+    MipOptions options;
+    options.threads = 1;
+    options.cuts = false;
+    options.heuristics = false;
+    options.node_limit = RENS_NODES;
+    auto result = branch_and_bound(sub, options);
+    if(result.x.empty())
+        return false;
+    solution = result.x;
+    return is_feasible(model, solution);
+}
+
+bool dive(const LPModel& model, Solver solver, std::vector<double> lower, std::vector<double> upper,
+          DiveRule rule, const std::vector<double>& guide, double cutoff, std::vector<double>& solution)
+{
+    double sign = model.maximize ? -1.0 : 1.0;
+    for(unsigned depth=0; depth<=DIVE_MAX_DEPTH; depth++)
+    {
+        if(solver.status() != SolverStatus::OPTIMAL || sign*solver.objective() >= cutoff)
+            return false;
+
+        // Step1: variable to round and direction of rounding
+        auto x = solver.x();
+        unsigned j = STOP;
+        bool up = false;
+        double best = INF;
+        for(unsigned k=0; k<x.size(); k++)
+        {
+            double fraction = phi(x.at(k));
+            if(!model.is_integer.at(k) || fraction == 0.0)
+                continue;
+            double score = (rule == DiveRule::FRACTIONAL) ? std::min(fraction, 1 - fraction) : std::fabs(x.at(k) - guide.at(k));
+            if(score < best)
+            {
+                best = score;
+                j = k;
+                up = (rule == DiveRule::FRACTIONAL) ? fraction >= 0.5 : guide.at(k) > x.at(k);
+            }
+        }
+        if(j == STOP)
+        {
+            solution = x;
+            round_integers(model, solution);
+            return is_feasible(model, solution);
+        }
+        if(depth == DIVE_MAX_DEPTH)
+            return false;
+
+        // Step2: bound of x(j) is changed and LP is solved again, infeasible side => other side
+        double low = lower.at(j), high = upper.at(j);
+        for(bool side: {up, !up})
+        {
+            lower.at(j) = side ? std::ceil(x.at(j)) : low;
+            upper.at(j) = side ? high : std::floor(x.at(j));
+            solver.set_bounds(j, lower.at(j), upper.at(j));
+            if(solver.solve() == SolverStatus::OPTIMAL)
+                break;
+        }
+    }
+    return false;
+}
+
+bool feasibility_pump(const LPModel& model, Solver solver, const std::vector<double>& lower,
+                      const std::vector<double>& upper, std::vector<double>& solution)
+{
+    unsigned n = model.cols();
+    Solver original = solver;
+    double sign = model.maximize ? -1.0 : 1.0;
+
+    // c is scaled to norm of distance objective (sqrt of number of integer variables)
+    unsigned integers = 0;
+    bool mixed = false;
+    for(unsigned j=0; j<n; j++)
+    {
+        integers += model.is_integer.at(j);
+        mixed = mixed || !model.is_integer.at(j);
+    }
+    double c_norm = norm(model.c), scale = (c_norm > 0.0) ? std::sqrt(integers)/c_norm : 0.0;
+
+    auto x = solver.x();
+    std::vector<double> rounded(n, 0.0);
+    std::vector<std::vector<double> > history;
+    std::mt19937 generator(PUMP_SEED);
+    double alpha = 1.0;
+    for(unsigned round=0; ; round++)
+    {
+        // Step1: x~ = rounding of x*
+        bool integral = true;
+        for(unsigned j=0; j<n; j++)
+            if(model.is_integer.at(j))
+            {
+                rounded.at(j) = std::min(upper.at(j), std::max(lower.at(j), std::round(x.at(j))));
+                integral = integral && phi(x.at(j)) == 0.0;
+            }
+        if(integral)
+            break;
+        if(round == PUMP_ITERATIONS)
+            return false;
+
+        std::vector<double> candidate = x;
+        for(unsigned j=0; j<n; j++)
+            if(model.is_integer.at(j))
+                candidate.at(j) = rounded.at(j);
+        if(!mixed && is_feasible(model, candidate))
+        {
+            solution = candidate;
+            return true;
+        }
+
+        // Step2: same rounding as in last round (short cycle) => variables with largest |x*(j) - x~(j)|
+        // are flipped, rounding of PUMP_HISTORY earlier rounds (long cycle) => restart: x(j) is flipped
+        // if |x*(j) - x~(j)| + max(r, 0) > 0.5 for random r in [-0.3, 0.7]
+        if(!history.empty() && rounded == history.back())
+        {
+            std::vector<std::pair<double, unsigned> > order;
+            for(unsigned j=0; j<n; j++)
+                if(model.is_integer.at(j) && phi(x.at(j)) != 0.0)
+                    order.push_back(std::make_pair(-std::fabs(x.at(j) - rounded.at(j)), j));
+            std::sort(order.begin(), order.end());
+            unsigned flips = PUMP_FLIPS/2 + generator()%PUMP_FLIPS;
+            for(unsigned k=0; k<order.size() && k<flips; k++)
+            {
+                unsigned j = order.at(k).second;
+                rounded.at(j) = (x.at(j) > rounded.at(j)) ? std::ceil(x.at(j)) : std::floor(x.at(j));
+            }
+        }
+        else if(std::find(history.begin(), history.end(), rounded) != history.end())
+        {
+            std::uniform_real_distribution<double> r(-0.3, 0.7);
+            for(unsigned j=0; j<n; j++)
+                if(model.is_integer.at(j) && std::fabs(x.at(j) - rounded.at(j)) + std::max(r(generator), 0.0) > 0.5)
+                {
+                    double step = (x.at(j) > rounded.at(j)) ? 1.0 : -1.0;
+                    rounded.at(j) = std::min(upper.at(j), std::max(lower.at(j), rounded.at(j) + step));
+                }
+        }
+        history.push_back(rounded);
+        if(history.size() > PUMP_HISTORY)
+            history.erase(history.begin());
+
+        // Step3: x* = argmin distance(x, x~) + alpha*c*x on LP relaxation
+        std::vector<double> d(n, 0.0);
+        for(unsigned j=0; j<n; j++)
+        {
+            if(model.is_integer.at(j))
+            {
+                if(rounded.at(j) <= lower.at(j))
+                    d.at(j) = 1.0;
+                else if(rounded.at(j) >= upper.at(j))
+                    d.at(j) = -1.0;
+                else if(x.at(j) != rounded.at(j))
+                    d.at(j) = (x.at(j) > rounded.at(j)) ? 1.0 : -1.0;
+            }
+            d.at(j) += alpha*scale*sign*model.c.at(j);
+        }
+        solver.set_objective(d, false);
+        if(solver.solve() != SolverStatus::OPTIMAL)
+            return false;
+        x = solver.x();
+        alpha *= PUMP_ALPHA_DECAY;
+    }
+
+    // Step4: continuous variables are solved again for c with integer variables fixed
+    if(mixed)
+    {
+        for(unsigned j=0; j<n; j++)
+            if(model.is_integer.at(j))
+                original.set_bounds(j, std::round(x.at(j)), std::round(x.at(j)));
+        if(original.solve() != SolverStatus::OPTIMAL)
+            return false;
+        x = original.x();
+    }
+    solution = x;
+    round_integers(model, solution);
+    return is_feasible(model, solution);
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef __HEURISTICS__
+#define __HEURISTICS__
+
+#include "cuts.hpp"
+
+// *PRIMAL HEURISTICS* (liblp)
+// Heuristics look for integer solution of LPModel (x(j) integer for is_integer(j)) near solution
+// of LP relaxation, found solution has value for every variable and is checked with is_feasible
+// Heuristics that solve LPs get copy of Solver with optimal base of relaxation (with bounds lower
+// and upper of integer variables, ex. bounds of branch and bound node) and change only its bounds
+// or objective, so every LP continues from last optimal base
+// cutoff ~ value of incumbent for min sign*c*x (sign = -1 for max, INF if there is no incumbent)
+
+// diving stops after DIVE_MAX_DEPTH bound changes
+#define DIVE_MAX_DEPTH 100
+// feasibility pump: rounds, variables whose rounding is flipped when rounding repeats,
+// weight of objective is multiplied by PUMP_ALPHA_DECAY every round (alpha = 1 at start)
+#define PUMP_ITERATIONS 30
+#define PUMP_FLIPS 10
+#define PUMP_ALPHA_DECAY 0.9
+// roundings of last PUMP_HISTORY rounds are kept to find cycles, restarts use seed PUMP_SEED
+#define PUMP_HISTORY 3
+#define PUMP_SEED 1
+// RENS: sub-problem is solved only if at least RENS_MIN_FIXED of integer variables are fixed,
+// branch and bound of sub-problem stops after RENS_NODES nodes
+#define RENS_MIN_FIXED 0.5
+#define RENS_NODES 500
+
+enum class DiveRule { FRACTIONAL, GUIDED };
+
+// work of one heuristic: calls, solutions found, solutions that improved incumbent, time
+struct HeuristicStats {
+    std::string name;
+    unsigned long calls = 0, found = 0, improved = 0;
+    double seconds = 0.0;
+};
+
+// rows (with ranges) and bounds hold with precision EPS*max(1, |b|), integer variables are integer
+bool is_feasible(const LPModel& model, const std::vector<double>& x);
+
+// c*x + c0
+double objective_value(const LPModel& model, const std::vector<double>& x);
+
+// Simple rounding: fractional x(j) is rounded down if no row can be violated by decreasing x(j)
+// (no down-lock: a(i, j) < 0 in '<' row, a(i, j) > 0 in '>' row, equation or ranged row),
+// up if no row can be violated by increasing x(j), otherwise rounding fails (no LP is solved)
+bool simple_rounding(const LPModel& model, const std::vector<double>& x, std::vector<double>& solution);
+
+// RENS (relaxation enforced neighborhood search): integer variables that are integral in x are
+// fixed, others get bounds floor(x(j)) <= x(j) <= ceil(x(j)), sub-problem is solved with
+// branch and bound (one thread, no cuts and heuristics, RENS_NODES nodes)
+bool rens(const LPModel& model, const std::vector<double>& x, const std::vector<double>& lower,
+          const std::vector<double>& upper, std::vector<double>& solution);
+
+// Diving: variable is rounded by changing its bound and LP is solved again (dual simplex from last
+// base) until x is integer, on infeasible LP the other side is tried once
+// FRACTIONAL ~ variable with smallest fractionality is rounded to nearest integer
+// GUIDED ~ variable closest to its value in guide (incumbent) is rounded towards guide
+bool dive(const LPModel& model, Solver solver, std::vector<double> lower, std::vector<double> upper,
+          DiveRule rule, const std::vector<double>& guide, double cutoff, std::vector<double>& solution);
+
+// Feasibility pump: x~ = rounding of x*, next x* minimizes distance to x~ on LP relaxation:
+// sum{x(j) | x~(j) = l(j)} + sum{-x(j) | x~(j) = u(j)} + linearized |x(j) - x~(j)| for other
+// integer variables (sign of x*(j) - x~(j)), plus alpha*c*x scaled to same norm (objective pump)
+// Solver::set_objective changes objective, so primal simplex continues from last base
+// Repeated rounding flips PUMP_FLIPS variables with largest |x*(j) - x~(j)|
+// When x* is integer continuous variables are solved again with integer variables fixed and c
+bool feasibility_pump(const LPModel& model, Solver solver, const std::vector<double>& lower,
+                      const std::vector<double>& upper, std::vector<double>& solution);
+
+#endif
\ No newline at end of file
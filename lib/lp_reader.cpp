@@ -0,0 +1,878 @@
+#include "lp_reader.hpp"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cctype>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+unsigned LPModel::rows() const
+{
+    return rhs.size();
+}
+
+unsigned LPModel::cols() const
+{
+    return c.size();
+}
+
+namespace {
+
+// Reads file line by line and counts lines and bytes
+class LineReader {
+private:
+    std::ifstream m_input;
+    std::string m_path, m_line;
+    ReadStats& m_stats;
+
+public:
+    LineReader(const std::string& path, ReadStats& stats)
+        : m_input(path), m_path(path), m_stats(stats)
+    {
+        if(m_input.fail())
+            throw std::runtime_error("Failed to open \"" + path + "\"!");
+        m_stats = ReadStats();
+    }
+
+    bool next()
+    {
+        if(!std::getline(m_input, m_line))
+            return false;
+        m_stats.lines++;
+        m_stats.bytes += m_line.size() + 1;
+        if(!m_line.empty() && m_line.back() == '\r')
+            m_line.pop_back();
+        return true;
+    }
+
+    const std::string& line() const
+    {
+        return m_line;
+    }
+
+    [[noreturn]] void error(const std::string& message) const
+    {
+        throw std::runtime_error(m_path + ":" + std::to_string(m_stats.lines) + ": " + message);
+    }
+};
+
+bool parse_number(std::string_view token, double& value)
+{
+    // std::from_chars does not accept leading '+'
+    if(!token.empty() && token.front() == '+')
+        token.remove_prefix(1);
+    if(token.empty())
+        return false;
+    auto[ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if(ec != std::errc() || ptr != token.data() + token.size())
+        return false;
+    if(value >= 1e30)
+        value = LP_INF;
+    else if(value <= -1e30)
+        value = -LP_INF;
+    return true;
+}
+
+double to_number(const LineReader& reader, std::string_view token)
+{
+    double value;
+    if(!parse_number(token, value))
+        reader.error("Invalid number \"" + std::string(token) + "\"!");
+    return value;
+}
+
+std::vector<std::string_view> split(std::string_view line)
+{
+    std::vector<std::string_view> tokens;
+    unsigned i = 0;
+    while(i < line.size())
+    {
+        while(i < line.size() && std::isspace((unsigned char)line[i]))
+            i++;
+        unsigned first = i;
+        while(i < line.size() && !std::isspace((unsigned char)line[i]))
+            i++;
+        if(i > first)
+            tokens.push_back(line.substr(first, i - first));
+    }
+    return tokens;
+}
+
+std::string to_lower(std::string_view token)
+{
+    std::string result(token);
+    for(auto& ch: result)
+        ch = std::tolower((unsigned char)ch);
+    return result;
+}
+
+// Collects rows, columns and non-zero values while file is read
+class ModelBuilder {
+private:
+    std::unordered_map<std::string, unsigned> m_cols, m_rows;
+    std::vector<Triplet> m_triplets;
+    std::chrono::steady_clock::time_point m_start;
+
+public:
+    LPModel model;
+
+    ModelBuilder()
+        : m_start(std::chrono::steady_clock::now())
+    {}
+
+    unsigned add_col(const std::string& name)
+    {
+        auto[it, inserted] = m_cols.emplace(name, model.cols());
+        if(inserted)
+        {
+            model.col_names.push_back(name);
+            model.c.push_back(0.0);
+            model.lower.push_back(0.0);
+            model.upper.push_back(LP_INF);
+            model.is_integer.push_back(false);
+        }
+        return it->second;
+    }
+
+    unsigned add_row(const std::string& name, char sense, double rhs)
+    {
+        auto[it, inserted] = m_rows.emplace(name, model.rows());
+        if(!inserted)
+            return STOP_ROW;
+        model.row_names.push_back(name);
+        model.sense.push_back(sense);
+        model.rhs.push_back(rhs);
+        model.range.push_back(LP_INF);
+        return it->second;
+    }
+
+    // STOP_ROW if there is no such row/column
+    unsigned find_row(const std::string& name) const
+    {
+        auto it = m_rows.find(name);
+        return (it == m_rows.end()) ? STOP_ROW : it->second;
+    }
+
+    unsigned find_col(const std::string& name) const
+    {
+        auto it = m_cols.find(name);
+        return (it == m_cols.end()) ? STOP_ROW : it->second;
+    }
+
+    void add_value(unsigned row, unsigned col, double value)
+    {
+        m_triplets.push_back({row, col, value});
+    }
+
+    LPModel finish(ReadStats& stats)
+    {
+        model.A = SparseMatrix(model.rows(), model.cols(), std::move(m_triplets));
+        stats.nonzeros = model.A.nonzeros();
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+        return std::move(model);
+    }
+
+    static constexpr unsigned STOP_ROW = (unsigned)-1;
+};
+
+// *MPS*
+
+enum class MPSSection { NONE, NAME, OBJSENSE, ROWS, COLUMNS, RHS, RANGES, BOUNDS, ENDATA };
+
+// Fixed MPS fields: 2-3, 5-12, 15-22, 25-36, 40-47, 50-61 (empty fields are skipped)
+std::vector<std::string_view> fixed_fields(std::string_view line, MPSSection section)
+{
+    static const unsigned position[6] = {1, 4, 14, 24, 39, 49};
+    static const unsigned length[6] = {2, 8, 8, 12, 8, 12};
+    std::vector<std::string_view> fields;
+    for(unsigned f=0; f<6; f++)
+    {
+        // field 1 is used only in ROWS and BOUNDS
+        if(f == 0 && section != MPSSection::ROWS && section != MPSSection::BOUNDS)
+            continue;
+        if(position[f] >= line.size())
+            break;
+        auto field = line.substr(position[f], length[f]);
+        while(!field.empty() && field.front() == ' ')
+            field.remove_prefix(1);
+        while(!field.empty() && field.back() == ' ')
+            field.remove_suffix(1);
+        if(!field.empty())
+            fields.push_back(field);
+    }
+    return fields;
+}
+
+} // namespace
+
+LPModel read_dense(const std::string& path, ReadStats& stats)
+{
+    LineReader reader(path, stats);
+    ModelBuilder builder;
+    LPModel& model = builder.model;
+
+    // tokens are read across lines
+    std::vector<std::string_view> tokens;
+    unsigned k = 0;
+    auto next_token = [&](std::string_view& token) {
+        while(k == tokens.size())
+        {
+            if(!reader.next())
+                return false;
+            tokens = split(reader.line());
+            k = 0;
+        }
+        token = tokens[k++];
+        return true;
+    };
+    auto next_number = [&]() {
+        std::string_view token;
+        if(!next_token(token))
+            reader.error("Unexpected end of file!");
+        return to_number(reader, token);
+    };
+
+    double in_n = next_number(), in_m = next_number();
+    if(in_n < 0 || in_m < 0 || in_n != std::floor(in_n) || in_m != std::floor(in_m))
+        reader.error("N and M must be non-negative integers!");
+    unsigned n = in_n, m = in_m;
+
+    for(unsigned j=0; j<n; j++)
+        builder.add_col("x" + std::to_string(j));
+    for(unsigned j=0; j<n; j++)
+        model.c.at(j) = next_number();
+
+    for(unsigned i=0; i<m; i++)
+    {
+        unsigned row = builder.add_row("r" + std::to_string(i), '<', 0.0);
+        for(unsigned j=0; j<n; j++)
+        {
+            double value = next_number();
+            if(value != 0.0)
+                builder.add_value(row, j, value);
+        }
+        std::string_view sign;
+        if(!next_token(sign) || (sign != "<" && sign != ">" && sign != "="))
+            reader.error("Sign must be '<', '>' or '='!");
+        model.sense.at(row) = sign.front();
+        model.rhs.at(row) = next_number();
+    }
+
+    // (optional) bounds section
+    std::string_view section;
+    if(next_token(section))
+    {
+        if(section != "bounds")
+            reader.error("Expected \"bounds\" section!");
+        double count = next_number();
+        for(unsigned b=0; b<count; b++)
+        {
+            double j = next_number(), lower = next_number(), upper = next_number();
+            if(j < 0 || j >= n || j != std::floor(j) || std::isinf(lower) || lower > upper)
+                reader.error("Invalid bound for variable x" + std::to_string((long)j) + "!");
+            model.lower.at((unsigned)j) = lower;
+            model.upper.at((unsigned)j) = upper;
+        }
+    }
+
+    return builder.finish(stats);
+}
+
+LPModel read_mps(const std::string& path, bool fixed, ReadStats& stats)
+{
+    LineReader reader(path, stats);
+    ModelBuilder builder;
+    LPModel& model = builder.model;
+
+    MPSSection section = MPSSection::NONE;
+    std::string objective;
+    std::unordered_set<std::string> free_rows;
+    std::vector<double> ranges;
+    bool integer = false;
+    std::string last_name;
+    unsigned last_col = 0;
+
+    // free rows (N rows after objective) are skipped
+    auto find_row = [&](std::string_view name) {
+        std::string row(name);
+        if(row == objective || free_rows.count(row))
+            return ModelBuilder::STOP_ROW - 1;
+        unsigned index = builder.find_row(row);
+        if(index == ModelBuilder::STOP_ROW)
+            reader.error("Unknown row \"" + row + "\"!");
+        return index;
+    };
+
+    while(reader.next())
+    {
+        std::string_view line = reader.line();
+        if(line.empty() || line.front() == '*' || split(line).empty())
+            continue;
+
+        // Section header starts in first column
+        if(!std::isspace((unsigned char)line.front()))
+        {
+            auto tokens = split(line);
+            std::string keyword(tokens.front());
+            if(keyword == "NAME")
+            {
+                section = MPSSection::NAME;
+                if(fixed && line.size() > 14)
+                {
+                    auto name = line.substr(14);
+                    while(!name.empty() && std::isspace((unsigned char)name.back()))
+                        name.remove_suffix(1);
+                    model.name = std::string(name);
+                }
+                else if(tokens.size() > 1)
+                    model.name = std::string(tokens.at(1));
+            }
+            else if(keyword == "OBJSENSE")
+            {
+                section = MPSSection::OBJSENSE;
+                if(tokens.size() > 1)
+                    model.maximize = (tokens.at(1) == "MAX" || tokens.at(1) == "MAXIMIZE");
+            }
+            else if(keyword == "ROWS")
+                section = MPSSection::ROWS;
+            else if(keyword == "COLUMNS")
+                section = MPSSection::COLUMNS;
+            else if(keyword == "RHS")
+                section = MPSSection::RHS;
+            else if(keyword == "RANGES")
+            {
+                section = MPSSection::RANGES;
+                ranges.assign(model.rows(), std::nan(""));
+            }
+            else if(keyword == "BOUNDS")
+                section = MPSSection::BOUNDS;
+            else if(keyword == "ENDATA")
+            {
+                section = MPSSection::ENDATA;
+                break;
+            }
+            else
+                reader.error("Unsupported section \"" + keyword + "\"!");
+            continue;
+        }
+
+        auto tokens = fixed ? fixed_fields(line, section) : split(line);
+        switch(section)
+        {
+            case MPSSection::OBJSENSE:
+                model.maximize = (tokens.front() == "MAX" || tokens.front() == "MAXIMIZE");
+                break;
+
+            case MPSSection::ROWS:
+            {
+                if(tokens.size() != 2)
+                    reader.error("Row must have type and name!");
+                std::string name(tokens.at(1));
+                if(tokens.at(0) == "N")
+                {
+                    if(objective.empty())
+                        objective = name;
+                    else
+                        free_rows.insert(name);
+                    break;
+                }
+                char sense = (tokens.at(0) == "L") ? '<' : (tokens.at(0) == "G") ? '>' : (tokens.at(0) == "E") ? '=' : 0;
+                if(sense == 0)
+                    reader.error("Unknown row type \"" + std::string(tokens.at(0)) + "\"!");
+                if(builder.add_row(name, sense, 0.0) == ModelBuilder::STOP_ROW)
+                    reader.error("Row \"" + name + "\" is defined twice!");
+                break;
+            }
+
+            case MPSSection::COLUMNS:
+            {
+                // integer markers: name 'MARKER' 'INTORG' ... name 'MARKER' 'INTEND'
+                if(tokens.size() >= 3 && tokens.at(1) == "'MARKER'")
+                {
+                    integer = (tokens.at(2) == "'INTORG'");
+                    break;
+                }
+                if(tokens.size() != 3 && tokens.size() != 5)
+                    reader.error("Column line must have 3 or 5 fields!");
+                // lines of same column are consecutive, so last column is checked first
+                if(tokens.at(0) != last_name)
+                {
+                    last_name = std::string(tokens.at(0));
+                    last_col = builder.add_col(last_name);
+                }
+                unsigned col = last_col;
+                if(integer)
+                    model.is_integer.at(col) = true;
+                for(unsigned k=1; k<tokens.size(); k+=2)
+                {
+                    double value = to_number(reader, tokens.at(k+1));
+                    if(tokens.at(k) == objective)
+                        model.c.at(col) += value;
+                    else
+                    {
+                        unsigned row = find_row(tokens.at(k));
+                        if(row < model.rows())
+                            builder.add_value(row, col, value);
+                    }
+                }
+                break;
+            }
+
+            case MPSSection::RHS:
+            case MPSSection::RANGES:
+            {
+                // set name is optional: [set] row value [row value]
+                unsigned first = tokens.size() % 2;
+                if(tokens.size() < 2 || tokens.size() > 5)
+                    reader.error("Invalid number of fields!");
+                for(unsigned k=first; k<tokens.size(); k+=2)
+                {
+                    double value = to_number(reader, tokens.at(k+1));
+                    // RHS of objective is -c0
+                    if(section == MPSSection::RHS && tokens.at(k) == objective)
+                    {
+                        model.c0 = -value;
+                        continue;
+                    }
+                    unsigned row = find_row(tokens.at(k));
+                    if(row >= model.rows())
+                        continue;
+                    if(section == MPSSection::RHS)
+                        model.rhs.at(row) = value;
+                    else
+                        ranges.at(row) = value;
+                }
+                break;
+            }
+
+            case MPSSection::BOUNDS:
+            {
+                // type [set] column [value]
+                if(tokens.empty())
+                    reader.error("Bound must have type!");
+                std::string type(tokens.front());
+                bool has_value = !(type == "FR" || type == "MI" || type == "PL" || type == "BV");
+                unsigned size = tokens.size() - (has_value ? 1 : 0);
+                if(size != 2 && size != 3)
+                    reader.error("Invalid number of fields!");
+                std::string name(tokens.at(size - 1));
+                unsigned col = builder.find_col(name);
+                if(col == ModelBuilder::STOP_ROW)
+                    reader.error("Unknown column \"" + name + "\"!");
+                double value = has_value ? to_number(reader, tokens.back()) : 0.0;
+
+                double& lower = model.lower.at(col);
+                double& upper = model.upper.at(col);
+                if(type == "UP" || type == "UI")
+                {
+                    upper = value;
+                    // negative upper bound with default lower bound makes variable unbounded below
+                    if(value < 0 && lower == 0.0)
+                        lower = -LP_INF;
+                }
+                else if(type == "LO" || type == "LI")
+                    lower = value;
+                else if(type == "FX")
+                    lower = upper = value;
+                else if(type == "FR")
+                {
+                    lower = -LP_INF;
+                    upper = LP_INF;
+                }
+                else if(type == "MI")
+                    lower = -LP_INF;
+                else if(type == "PL")
+                    upper = LP_INF;
+                else if(type == "BV")
+                {
+                    lower = 0.0;
+                    upper = 1.0;
+                }
+                else
+                    reader.error("Unsupported bound type \"" + type + "\"!");
+                if(type == "UI" || type == "LI" || type == "BV")
+                    model.is_integer.at(col) = true;
+                break;
+            }
+
+            default:
+                reader.error("Data line outside of section!");
+        }
+    }
+    if(section != MPSSection::ENDATA)
+        reader.error("Missing ENDATA!");
+    if(objective.empty())
+        reader.error("Missing objective row (N)!");
+
+    // Ranges: L and G rows get range |R|, E row becomes [rhs, rhs + R] (R > 0) or [rhs + R, rhs] (R < 0)
+    for(unsigned i=0; i<ranges.size(); i++)
+    {
+        double R = ranges.at(i);
+        if(std::isnan(R))
+            continue;
+        if(model.sense.at(i) == '=')
+        {
+            if(R == 0.0)
+                continue;
+            model.sense.at(i) = (R > 0) ? '>' : '<';
+        }
+        model.range.at(i) = std::fabs(R);
+    }
+
+    return builder.finish(stats);
+}
+
+namespace {
+
+// *CPLEX LP*
+
+enum class LPSection { NONE, OBJECTIVE, CONSTRAINTS, BOUNDS, GENERALS, BINARIES, END };
+
+struct LPToken {
+    enum Kind { NAME, NUMBER, OP } kind;
+    std::string text;
+    double value;
+};
+
+// Operators: + - : < > = (<= and =< are '<', >= and => are '>'), '\' starts comment
+std::vector<LPToken> lp_tokens(const LineReader& reader)
+{
+    const std::string& line = reader.line();
+    std::vector<LPToken> tokens;
+    unsigned i = 0;
+    while(i < line.size())
+    {
+        char ch = line[i];
+        if(std::isspace((unsigned char)ch))
+        {
+            i++;
+            continue;
+        }
+        if(ch == '\\')
+            break;
+        if(ch == '<' || ch == '>' || ch == '=')
+        {
+            char op = ch;
+            i++;
+            if(i < line.size() && (line[i] == '<' || line[i] == '>' || line[i] == '='))
+            {
+                if(op == '=')
+                    op = line[i];
+                i++;
+            }
+            tokens.push_back({LPToken::OP, std::string(1, op), 0.0});
+            continue;
+        }
+        if(ch == '+' || ch == '-' || ch == ':')
+        {
+            tokens.push_back({LPToken::OP, std::string(1, ch), 0.0});
+            i++;
+            continue;
+        }
+        if(std::isdigit((unsigned char)ch) || ch == '.')
+        {
+            double value;
+            auto[ptr, ec] = std::from_chars(line.data() + i, line.data() + line.size(), value);
+            if(ec != std::errc())
+                reader.error("Invalid number!");
+            unsigned length = ptr - (line.data() + i);
+            tokens.push_back({LPToken::NUMBER, line.substr(i, length), (value >= 1e30) ? LP_INF : value});
+            i += length;
+            continue;
+        }
+        unsigned first = i;
+        while(i < line.size() && !std::isspace((unsigned char)line[i]) && std::string("+-:<>=\\").find(line[i]) == std::string::npos)
+            i++;
+        std::string name = line.substr(first, i - first);
+        std::string lower = to_lower(name);
+        if(lower == "inf" || lower == "infinity")
+            tokens.push_back({LPToken::NUMBER, name, LP_INF});
+        else
+            tokens.push_back({LPToken::NAME, name, 0.0});
+    }
+    return tokens;
+}
+
+// Section keyword at line start, tokens used by keyword are skipped
+LPSection lp_section(const std::vector<LPToken>& tokens, unsigned& k)
+{
+    if(tokens.empty() || tokens[0].kind != LPToken::NAME)
+        return LPSection::NONE;
+    // "name:" is label of objective or constraint
+    if(tokens.size() > 1 && tokens[1].text == ":")
+        return LPSection::NONE;
+    std::string word = to_lower(tokens[0].text);
+    std::string second = (tokens.size() > 1) ? to_lower(tokens[1].text) : "";
+    k = 1;
+    if(word == "minimize" || word == "minimum" || word == "min" ||
+       word == "maximize" || word == "maximum" || word == "max")
+        return LPSection::OBJECTIVE;
+    if((word == "subject" && second == "to") || (word == "such" && second == "that"))
+    {
+        k = 2;
+        return LPSection::CONSTRAINTS;
+    }
+    if(word == "st" || word == "s.t." || word == "st.")
+        return LPSection::CONSTRAINTS;
+    if(word == "bounds" || word == "bound")
+        return LPSection::BOUNDS;
+    if(word == "general" || word == "generals" || word == "gen" || word == "integer" || word == "integers")
+        return LPSection::GENERALS;
+    if(word == "binary" || word == "binaries" || word == "bin")
+        return LPSection::BINARIES;
+    if(word == "end")
+        return LPSection::END;
+    k = 0;
+    return LPSection::NONE;
+}
+
+// Linear expression (sum of [sign] [number] name) which can span multiple lines
+struct LPExpression {
+    std::string label;
+    std::vector<std::pair<unsigned, double> > terms;
+    double constant = 0.0, sign = 1.0, coef = 1.0;
+    bool has_coef = false, empty = true;
+    char op = 0;
+
+    void flush_constant()
+    {
+        if(has_coef)
+            constant += sign*coef;
+        sign = 1.0;
+        coef = 1.0;
+        has_coef = false;
+    }
+};
+
+} // namespace
+
+LPModel read_lp(const std::string& path, ReadStats& stats)
+{
+    LineReader reader(path, stats);
+    ModelBuilder builder;
+    LPModel& model = builder.model;
+
+    LPSection section = LPSection::NONE;
+    LPExpression expression;
+
+    auto finish_objective = [&]() {
+        expression.flush_constant();
+        model.c0 += expression.constant;
+        for(auto[col, value]: expression.terms)
+            model.c.at(col) += value;
+        expression = LPExpression();
+    };
+
+    while(reader.next())
+    {
+        auto tokens = lp_tokens(reader);
+        unsigned k = 0;
+        LPSection next = lp_section(tokens, k);
+        if(next != LPSection::NONE)
+        {
+            if(section == LPSection::OBJECTIVE)
+                finish_objective();
+            if(section == LPSection::CONSTRAINTS && !expression.empty)
+                reader.error("Constraint is not finished!");
+            if(next == LPSection::OBJECTIVE)
+            {
+                std::string word = to_lower(tokens[0].text);
+                model.maximize = (word.substr(0, 3) == "max");
+            }
+            section = next;
+            if(section == LPSection::END)
+                break;
+        }
+
+        switch(section)
+        {
+            case LPSection::OBJECTIVE:
+            case LPSection::CONSTRAINTS:
+                for(; k<tokens.size(); k++)
+                {
+                    const LPToken& token = tokens[k];
+                    if(token.kind == LPToken::NAME && k+1 < tokens.size() && tokens[k+1].text == ":")
+                    {
+                        expression.label = token.text;
+                        expression.empty = false;
+                        k++;
+                    }
+                    else if(token.kind == LPToken::OP && (token.text == "+" || token.text == "-"))
+                    {
+                        if(token.text == "-")
+                            expression.sign = -expression.sign;
+                        expression.empty = false;
+                    }
+                    else if(token.kind == LPToken::NUMBER && expression.op != 0)
+                    {
+                        // right side finishes constraint
+                        double rhs = expression.sign*token.value - expression.constant;
+                        std::string name = expression.label.empty() ? "R" + std::to_string(model.rows()) : expression.label;
+                        unsigned row = builder.add_row(name, expression.op, rhs);
+                        if(row == ModelBuilder::STOP_ROW)
+                            reader.error("Row \"" + name + "\" is defined twice!");
+                        for(auto[col, value]: expression.terms)
+                            builder.add_value(row, col, value);
+                        expression = LPExpression();
+                    }
+                    else if(token.kind == LPToken::NUMBER)
+                    {
+                        if(expression.has_coef)
+                            reader.error("Expected variable after number!");
+                        expression.coef = token.value;
+                        expression.has_coef = true;
+                        expression.empty = false;
+                    }
+                    else if(token.kind == LPToken::NAME && expression.op == 0)
+                    {
+                        unsigned col = builder.add_col(token.text);
+                        expression.terms.push_back(std::make_pair(col, expression.sign*expression.coef));
+                        expression.sign = 1.0;
+                        expression.coef = 1.0;
+                        expression.has_coef = false;
+                        expression.empty = false;
+                    }
+                    else if(token.kind == LPToken::OP && section == LPSection::CONSTRAINTS && expression.op == 0 &&
+                            (token.text == "<" || token.text == ">" || token.text == "="))
+                    {
+                        expression.flush_constant();
+                        expression.op = token.text.front();
+                    }
+                    else
+                        reader.error("Unexpected \"" + token.text + "\"!");
+                }
+                break;
+
+            case LPSection::BOUNDS:
+            {
+                if(k == tokens.size())
+                    break;
+                // signed numbers are merged: - inf => -inf
+                std::vector<LPToken> items;
+                for(; k<tokens.size(); k++)
+                {
+                    if(tokens[k].kind == LPToken::OP && (tokens[k].text == "+" || tokens[k].text == "-") &&
+                       k+1 < tokens.size() && tokens[k+1].kind == LPToken::NUMBER)
+                    {
+                        items.push_back(tokens[k+1]);
+                        if(tokens[k].text == "-")
+                            items.back().value = -items.back().value;
+                        k++;
+                    }
+                    else
+                        items.push_back(tokens[k]);
+                }
+
+                auto is_op = [&](unsigned i) {
+                    return items[i].kind == LPToken::OP && std::string("<>=").find(items[i].text) != std::string::npos;
+                };
+                auto set_bound = [&](unsigned col, char op, double value, bool value_on_left) {
+                    if(op == '=')
+                        model.lower.at(col) = model.upper.at(col) = value;
+                    else if((op == '<') != value_on_left)
+                        model.upper.at(col) = value;
+                    else
+                        model.lower.at(col) = value;
+                };
+
+                if(items.size() == 2 && items[0].kind == LPToken::NAME && to_lower(items[1].text) == "free")
+                {
+                    unsigned col = builder.add_col(items[0].text);
+                    model.lower.at(col) = -LP_INF;
+                    model.upper.at(col) = LP_INF;
+                }
+                else if(items.size() == 3 && items[0].kind == LPToken::NAME && is_op(1) && items[2].kind == LPToken::NUMBER)
+                    set_bound(builder.add_col(items[0].text), items[1].text.front(), items[2].value, false);
+                else if(items.size() == 3 && items[0].kind == LPToken::NUMBER && is_op(1) && items[2].kind == LPToken::NAME)
+                    set_bound(builder.add_col(items[2].text), items[1].text.front(), items[0].value, true);
+                else if(items.size() == 5 && items[0].kind == LPToken::NUMBER && is_op(1) && items[2].kind == LPToken::NAME &&
+                        is_op(3) && items[4].kind == LPToken::NUMBER && items[1].text == items[3].text && items[1].text != "=")
+                {
+                    unsigned col = builder.add_col(items[2].text);
+                    set_bound(col, items[1].text.front(), items[0].value, true);
+                    set_bound(col, items[3].text.front(), items[4].value, false);
+                }
+                else
+                    reader.error("Invalid bound!");
+                break;
+            }
+
+            case LPSection::GENERALS:
+            case LPSection::BINARIES:
+                for(; k<tokens.size(); k++)
+                {
+                    if(tokens[k].kind != LPToken::NAME)
+                        reader.error("Expected variable name!");
+                    unsigned col = builder.add_col(tokens[k].text);
+                    model.is_integer.at(col) = true;
+                    if(section == LPSection::BINARIES)
+                    {
+                        model.lower.at(col) = 0.0;
+                        model.upper.at(col) = 1.0;
+                    }
+                }
+                break;
+
+            default:
+                if(k < tokens.size())
+                    reader.error("Expected section (Minimize, Maximize, Subject To, ...)!");
+        }
+    }
+    if(section == LPSection::OBJECTIVE)
+        finish_objective();
+    if(section == LPSection::CONSTRAINTS && !expression.empty)
+        reader.error("Constraint is not finished!");
+
+    return builder.finish(stats);
+}
+
+LPModel read_model(const std::string& path, bool fixed_mps, ReadStats& stats)
+{
+    auto extension = [&](const std::string& ext) {
+        return path.size() >= ext.size() && to_lower(path.substr(path.size() - ext.size())) == ext;
+    };
+    if(extension(".mps"))
+        return read_mps(path, fixed_mps, stats);
+    if(extension(".lp"))
+        return read_lp(path, stats);
+    return read_dense(path, stats);
+}
+
+LPModel dense_model(const Matrix& A, const Matrix& b, const Matrix& c, const std::vector<char>& sense)
+{
+    if(b.width() != A.height() || c.width() != A.width() || sense.size() != A.height())
+        throw std::invalid_argument("Dimensions of A, b, c and sense do not match!");
+
+    ModelBuilder builder;
+    LPModel& model = builder.model;
+    for(unsigned j=0; j<A.width(); j++)
+        model.c.at(builder.add_col("x" + std::to_string(j))) = c.at(0, j);
+    for(unsigned i=0; i<A.height(); i++)
+    {
+        unsigned row = builder.add_row("r" + std::to_string(i), sense.at(i), b.at(0, i));
+        for(unsigned j=0; j<A.width(); j++)
+            if(A.at(i, j) != 0.0)
+                builder.add_value(row, j, A.at(i, j));
+    }
+
+    ReadStats stats;
+    return builder.finish(stats);
+}
+
+void print_read_stats(std::ostream& out, const LPModel& model, const ReadStats& stats)
+{
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(2);
+    line << "Read model";
+    if(!model.name.empty())
+        line << " \"" << model.name << "\"";
+    line << ": " << model.rows() << " rows, " << model.cols() << " columns, " << stats.nonzeros << " nonzeros" << std::endl;
+    line << "Parsed " << stats.lines << " lines (" << stats.bytes << " bytes) in " << stats.seconds*1000 << " ms";
+    if(stats.seconds > 0)
+        line << " => " << stats.bytes/stats.seconds/1e6 << " MB/s, " << stats.nonzeros/stats.seconds << " nonzeros/s";
+    out << line.str() << std::endl;
+}
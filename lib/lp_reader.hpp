@@ -0,0 +1,72 @@
+#ifndef __LP_READER__
+#define __LP_READER__
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <iostream>
+#include "sparse_matrix.hpp"
+#include "matrix.hpp"
+
+// LP model: min (or max) c*x + c0
+//           A(i)*x sense(i) rhs(i)
+//           lower(j) <= x(j) <= upper(j)
+// sense is '<', '>' or '='
+// Ranged row has range(i) < inf: rhs(i) - range(i) <= A(i)*x <= rhs(i) for '<'
+//                                rhs(i) <= A(i)*x <= rhs(i) + range(i) for '>'
+// (ranged '=' row from MPS is stored as '<' or '>' row)
+struct LPModel {
+    std::string name;
+    bool maximize = false;
+    std::vector<std::string> col_names, row_names;
+    std::vector<double> c;
+    double c0 = 0.0;
+    std::vector<char> sense;
+    std::vector<double> rhs, range;
+    std::vector<double> lower, upper;
+    std::vector<bool> is_integer;
+    SparseMatrix A;
+
+    unsigned rows() const;
+    unsigned cols() const;
+};
+
+// Parsing statistics (throughput = bytes/seconds)
+struct ReadStats {
+    std::size_t bytes = 0, lines = 0;
+    unsigned nonzeros = 0;
+    double seconds = 0.0;
+};
+
+const double LP_INF = std::numeric_limits<double>::infinity();
+
+// All readers read file line by line (model is never stored as text) and throw
+// std::runtime_error with line number if file can't be parsed
+// Numbers are parsed with std::from_chars, values >= 1e30 are treated as infinity
+
+// Dense text format:
+// N M
+// c1 c2 ... cN
+// A11 A12 ... A1N * b1   ('*' is '<', '>' or '=')
+// ...
+// (optional) bounds K
+//            j l u       (K lines, u can be inf)
+LPModel read_dense(const std::string& path, ReadStats& stats);
+
+// Free MPS (fields are separated with whitespace) or fixed MPS (fields are
+// in columns 2-3, 5-12, 15-22, 25-36, 40-47, 50-61 and names can contain spaces)
+LPModel read_mps(const std::string& path, bool fixed, ReadStats& stats);
+
+// CPLEX LP format (Minimize/Maximize, Subject To, Bounds, Generals, Binaries, End)
+LPModel read_lp(const std::string& path, ReadStats& stats);
+
+// Format is chosen by extension: .mps ~ MPS (fixed if fixed_mps is true), .lp ~ CPLEX LP, other ~ dense
+LPModel read_model(const std::string& path, bool fixed_mps, ReadStats& stats);
+
+// Model from matrices in memory: min c*x, A(i)*x sense(i) b(i), x >= 0
+// (b and c have shape 1xM and 1xN, columns are named x0, x1, ... and rows r0, r1, ...)
+LPModel dense_model(const Matrix& A, const Matrix& b, const Matrix& c, const std::vector<char>& sense);
+
+void print_read_stats(std::ostream& out, const LPModel& model, const ReadStats& stats);
+
+#endif
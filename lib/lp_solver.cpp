@@ -0,0 +1,844 @@
+#include "lp_solver.hpp"
+
+// Output of solvers (out()) goes to given stream while guard exists
+class OutputGuard {
+private:
+    std::ostream& m_previous;
+
+public:
+    OutputGuard(std::ostream& stream)
+        : m_previous(out())
+    {
+        set_output(stream);
+    }
+
+    ~OutputGuard()
+    {
+        set_output(m_previous);
+    }
+};
+
+std::string to_string(SolverStatus status)
+{
+    switch(status)
+    {
+        case SolverStatus::UNSOLVED:   return "unsolved";
+        case SolverStatus::OPTIMAL:    return "optimal";
+        case SolverStatus::INFEASIBLE: return "infeasible";
+        case SolverStatus::UNBOUNDED:  return "unbounded";
+        case SolverStatus::FAILED:     return "failed";
+        case SolverStatus::CANCELLED:  return "cancelled";
+    }
+    return "unknown";
+}
+
+void Solver::load(const LPModel& model)
+{
+    // n - number of vars
+    // m - number of rows
+    // max c*x is solved as min (-c)*x
+    unsigned n = model.cols(), m = model.rows();
+    std::vector<std::vector<double> > in_A = model.A.to_dense().to_cpp_matrix();
+    std::vector<double> in_c = model.c, in_b = model.rhs;
+    if(model.maximize)
+        for(auto& value: in_c)
+            value = -value;
+
+    // Variable bounds l(j) <= x(j) <= u(j) are transformed to 0 <= x'(j) <= u'(j)
+    // F_shift ~ value of c*x that is moved out of system by shifting
+    std::vector<double> offset(n, 0.0), direction(n, 1.0), in_upper(n, INF);
+    std::vector<unsigned> split(n, STOP);
+    double F_shift = 0.0;
+    for(unsigned j=0; j<n; j++)
+    {
+        double lower = model.lower.at(j), upper = model.upper.at(j);
+        if(lower > upper)
+            throw std::invalid_argument("Invalid bound for variable " + model.col_names.at(j) + "!");
+        if(!std::isinf(lower))
+        {
+            offset.at(j) = lower;
+            in_upper.at(j) = std::isinf(upper) ? INF : upper - lower;
+        }
+        else if(!std::isinf(upper))
+        {
+            offset.at(j) = upper;
+            direction.at(j) = -1.0;
+        }
+        else
+        {
+            split.at(j) = in_c.size();
+            for(unsigned i=0; i<m; i++)
+                in_A.at(i).push_back(-in_A.at(i).at(j));
+            in_c.push_back(-in_c.at(j));
+            in_upper.push_back(INF);
+        }
+
+        if(offset.at(j) != 0.0)
+        {
+            for(unsigned i=0; i<m; i++)
+                in_b.at(i) -= in_A.at(i).at(j)*offset.at(j);
+            F_shift += in_c.at(j)*offset.at(j);
+        }
+        if(direction.at(j) < 0)
+        {
+            for(unsigned i=0; i<m; i++)
+                in_A.at(i).at(j) *= -1;
+            in_c.at(j) *= -1;
+        }
+    }
+    unsigned width = in_c.size();
+
+    // Slack variables are not added to A, every row i gets logical variable s(i) (column N+i):
+    // x1 + x2 + x3 ... xN <= c
+    // => x1 + x2 + x3 ... xN + s = c, 0 <= s <= range(i)
+    // if sign is > then row is multiplied by -1
+    // Logical variable of equation is fixed: 0 <= s <= 0
+    for(unsigned i=0; i<m; i++)
+    {
+        char sense = model.sense.at(i);
+        if(sense == '>')
+        {
+            for(unsigned j=0; j<width; j++)
+                in_A.at(i).at(j) *= -1;
+            in_b.at(i) *= -1;
+        }
+        if(sense == '=')
+            in_upper.push_back(0.0);
+        else
+            in_upper.push_back(std::isinf(model.range.at(i)) ? INF : model.range.at(i));
+    }
+
+    m_cols = n;
+    m_rows = m;
+    m_maximize = model.maximize;
+    m_c0 = model.c0;
+    m_F_shift = F_shift;
+    m_offset = offset;
+    m_direction = direction;
+    m_split = split;
+    m_sense = model.sense;
+    // Matrix(vector) is row vector, A with no rows still has width columns
+    m_A = (m > 0) ? Matrix(in_A) : Matrix(0, width);
+    m_b = Matrix(in_b);
+    m_c = Matrix(in_c);
+    m_upper = Matrix(in_upper);
+
+    m_status = SolverStatus::UNSOLVED;
+    m_F = 0.0;
+    m_x = Matrix();
+    m_P.clear();
+    m_Q.clear();
+    m_at_upper.clear();
+    m_dual_feasible = false;
+    m_factorization.reset();
+}
+
+void Solver::set_method(SolverMethod method)
+{
+    m_method = method;
+}
+
+void Solver::set_scaling(bool scaling)
+{
+    m_scaling = scaling;
+    m_factorization.reset();
+}
+
+void Solver::set_crossover(bool crossover)
+{
+    m_crossover = crossover;
+}
+
+void Solver::set_lexicographic(bool lexicographic)
+{
+    m_lexicographic = lexicographic;
+}
+
+void Solver::set_threads(unsigned threads)
+{
+    m_threads = threads;
+}
+
+void Solver::set_cancel(const std::atomic<bool>* cancel)
+{
+    m_cancel = cancel;
+}
+
+void Solver::set_log(std::ostream* log)
+{
+    m_log = log;
+}
+
+void Solver::set_basis(const std::vector<unsigned>& P, const std::vector<bool>& at_upper)
+{
+    m_P = P;
+    m_Q = get_Q(P, width());
+    m_at_upper = at_upper;
+    m_dual_feasible = false;
+    m_factorization.reset();
+}
+
+void Solver::set_bounds(unsigned j, double lower, double upper)
+{
+    if(j >= m_cols || m_direction.at(j) < 0 || m_split.at(j) != STOP)
+        throw std::invalid_argument("Bounds can be changed only for variables with lower bound!");
+    if(std::isinf(lower) || lower > upper)
+        throw std::invalid_argument("Invalid bound for variable " + std::to_string(j) + "!");
+
+    // x(j) = l(j) + x'(j): b -= A(j)*(l(j) - offset(j)) and F_shift += c(j)*(l(j) - offset(j))
+    double delta = lower - m_offset.at(j);
+    if(delta != 0.0)
+    {
+        for(unsigned i=0; i<m_A.height(); i++)
+            m_b.at(0, i) -= m_A.at(i, j)*delta;
+        m_F_shift += m_c.at(0, j)*delta;
+        m_offset.at(j) = lower;
+    }
+    double old_upper = m_upper.at(0, j);
+    m_upper.at(0, j) = std::isinf(upper) ? INF : upper - lower;
+
+    bool keep = (m_status == SolverStatus::OPTIMAL || m_dual_feasible) && m_P.size() == m_A.height();
+    // fixed nonbase variable (u'(j) = 0) is never priced, so sign of its r(j) is not known:
+    // after widening its bound base does not have to be dual feasible
+    if(old_upper == 0.0 && m_upper.at(0, j) > 0.0 && std::find(m_P.begin(), m_P.end(), j) == m_P.end())
+        keep = false;
+    if(!m_at_upper.empty() && m_at_upper.at(j) && m_upper.at(0, j) == INF)
+    {
+        m_at_upper.at(j) = false;
+        keep = false;
+    }
+    if(!keep)
+        m_factorization.reset();
+    m_dual_feasible = keep;
+    m_status = SolverStatus::UNSOLVED;
+    m_x = Matrix();
+}
+
+void Solver::set_objective(const std::vector<double>& c, bool maximize)
+{
+    if(c.size() != m_cols)
+        throw std::invalid_argument("Objective must have value for every variable!");
+
+    // same transformation as in load: max c*x => min (-c)*x, x(j) = offset(j) + direction(j)*x'(j)
+    Matrix in_c(1, m_c.width());
+    double F_shift = 0.0;
+    for(unsigned j=0; j<m_cols; j++)
+    {
+        double value = maximize ? -c.at(j) : c.at(j);
+        in_c.at(0, j) = value*m_direction.at(j);
+        F_shift += value*m_offset.at(j);
+        if(m_split.at(j) != STOP)
+            in_c.at(0, m_split.at(j)) = -value;
+    }
+    m_c = in_c;
+    m_F_shift = F_shift;
+    m_maximize = maximize;
+    m_dual_feasible = false;
+    m_status = SolverStatus::UNSOLVED;
+    m_x = Matrix();
+}
+
+void Solver::add_rows(const std::vector<std::vector<double> >& rows, const std::vector<char>& sense,
+                      const std::vector<double>& rhs)
+{
+    if(rows.size() != sense.size() || rows.size() != rhs.size())
+        throw std::invalid_argument("Every new row needs sense and right side!");
+    unsigned n = m_A.width(), m = m_A.height();
+
+    bool keep = (m_status == SolverStatus::OPTIMAL || m_dual_feasible) && m_P.size() == m;
+
+    // Row of original variables is transformed to columns of system:
+    // x(j) = offset(j) + direction(j)*x'(j) (- x''(j) for split free variable)
+    // row with sense '>' is multiplied by -1, logical variable of equation is fixed
+    for(unsigned k=0; k<rows.size(); k++)
+        if(rows.at(k).size() != m_cols)
+            throw std::invalid_argument("Row must have value for every variable!");
+    for(unsigned k=0; k<rows.size(); k++)
+    {
+        const auto& a = rows.at(k);
+        std::vector<double> row(n, 0.0);
+        double value = rhs.at(k);
+        for(unsigned j=0; j<m_cols; j++)
+        {
+            row.at(j) = a.at(j)*m_direction.at(j);
+            value -= a.at(j)*m_offset.at(j);
+            if(m_split.at(j) != STOP)
+                row.at(m_split.at(j)) = -a.at(j);
+        }
+        if(sense.at(k) == '>')
+        {
+            for(auto& coef: row)
+                coef = -coef;
+            value = -value;
+        }
+        append_row(m_A, row);
+        append(m_b, Matrix(1, 1, value));
+        append(m_upper, Matrix(1, 1, (sense.at(k) == '=') ? 0.0 : INF));
+        m_sense.push_back(sense.at(k));
+    }
+    m_rows += rows.size();
+
+    // Logical column of new row k is N+M+k: it is appended to base (B' = [B 0; a(P) 1])
+    // Factorization of B is bordered by scaled row (R*a*S with scale of new row from equilibration,
+    // logical columns of B have 0 in new row)
+    if(keep)
+    {
+        for(unsigned k=0; k<rows.size(); k++)
+        {
+            if(m_factorization)
+            {
+                double max_value = 0.0;
+                for(unsigned j=0; j<n; j++)
+                    max_value = std::max(max_value, std::fabs(m_A.at(m+k, j)*m_col_scale.at(0, j)));
+                double scale = (m_scaling && max_value > 0.0) ? round_to_power_of_two(1.0/max_value) : 1.0;
+                Matrix a(1, m_P.size());
+                for(unsigned i=0; i<m_P.size(); i++)
+                    if(m_P.at(i) < n)
+                        a.at(0, i) = scale*m_A.at(m+k, m_P.at(i))*m_col_scale.at(0, m_P.at(i));
+                m_factorization->add_row(a);
+                append(m_row_scale, Matrix(1, 1, scale));
+            }
+            m_P.push_back(n+m+k);
+            m_at_upper.push_back(false);
+        }
+        m_Q = get_Q(m_P, width());
+        m_dual_feasible = true;
+    }
+    else
+    {
+        m_P.clear();
+        m_Q.clear();
+        m_at_upper.clear();
+        m_dual_feasible = false;
+        m_factorization.reset();
+    }
+    m_status = SolverStatus::UNSOLVED;
+    m_x = Matrix();
+}
+
+void Solver::remove_rows(std::vector<unsigned> rows)
+{
+    unsigned n = m_A.width(), m = m_A.height();
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    if(rows.empty())
+        return;
+    if(rows.back() >= m)
+        throw std::invalid_argument("Row is out of range!");
+
+    // new index of every column of system (STOP for logical columns of removed rows)
+    std::vector<bool> removed(m, false);
+    for(auto i: rows)
+        removed.at(i) = true;
+    std::vector<unsigned> column(n+m, STOP);
+    unsigned k = n;
+    for(unsigned j=0; j<n; j++)
+        column.at(j) = j;
+    for(unsigned i=0; i<m; i++)
+        if(!removed.at(i))
+            column.at(n+i) = k++;
+
+    // Base is kept only if logical variables of all removed rows are in base
+    std::vector<bool> is_base(n+m, false);
+    for(auto p: m_P)
+        is_base.at(p) = true;
+    bool keep = m_P.size() == m;
+    for(auto i: rows)
+        keep = keep && is_base.at(n+i);
+
+    auto in_A = m_A.to_cpp_matrix();
+    std::vector<std::vector<double> > new_A;
+    std::vector<double> new_b, new_upper(m_upper.width() - rows.size());
+    std::vector<char> new_sense;
+    for(unsigned i=0; i<m; i++)
+        if(!removed.at(i))
+        {
+            new_A.push_back(in_A.at(i));
+            new_b.push_back(m_b.at(0, i));
+            new_sense.push_back(m_sense.at(i));
+        }
+    for(unsigned j=0; j<n+m; j++)
+        if(column.at(j) != STOP)
+            new_upper.at(column.at(j)) = m_upper.at(0, j);
+    m_A = new_A.empty() ? Matrix(0, n) : Matrix(new_A);
+    m_b = Matrix(new_b);
+    m_upper = Matrix(new_upper);
+    m_sense = new_sense;
+    m_rows -= rows.size();
+    m_factorization.reset();
+
+    if(keep)
+    {
+        std::vector<unsigned> P;
+        std::vector<bool> at_upper(n+m-rows.size(), false);
+        for(auto p: m_P)
+            if(column.at(p) != STOP)
+                P.push_back(column.at(p));
+        for(unsigned j=0; j<n+m; j++)
+            if(column.at(j) != STOP)
+                at_upper.at(column.at(j)) = m_at_upper.at(j);
+        m_P = P;
+        m_Q = get_Q(P, width());
+        m_at_upper = at_upper;
+        if(m_status == SolverStatus::OPTIMAL)
+        {
+            Matrix x(1, width());
+            for(unsigned j=0; j<n+m; j++)
+                if(column.at(j) != STOP)
+                    x.at(0, column.at(j)) = m_x.at(0, j);
+            m_x = x;
+        }
+    }
+    else
+    {
+        m_P.clear();
+        m_Q.clear();
+        m_at_upper.clear();
+        m_dual_feasible = false;
+        m_status = SolverStatus::UNSOLVED;
+        m_x = Matrix();
+    }
+}
+
+SolverStatus Solver::solve()
+{
+    // without log output goes to stream without buffer (every write fails and is ignored)
+    std::ostream null_output(nullptr);
+    OutputGuard guard(m_log ? *m_log : null_output);
+
+    Matrix A = m_A, b = m_b, c = m_c, upper = m_upper;
+    unsigned n = A.width(), m = A.height();
+    out() << "Solving system(canonical form): Ax + s = b" << std::endl;
+    show_system(A, b, c);
+    out() << BAR << std::endl;
+
+    // Scaling (identity scale if scaling is turned off):
+    // Scale factors of last solve are kept while its factorization of base is kept (add_rows, set_bounds)
+    Matrix row_scale(1, m, 1.0), col_scale(1, n, 1.0);
+    if(m_scaling && m > 0)
+    {
+        out() << "Scaling ratio (max|A(i, j)|/min|A(i, j)|): " << scaling_ratio(A);
+        if(m_factorization && m_row_scale.width() == m && m_col_scale.width() == n)
+        {
+            scale_rows(A, b, row_scale, m_row_scale);
+            scale_columns(A, c, col_scale, m_col_scale);
+        }
+        else
+            std::tie(row_scale, col_scale) = scale_system(A, b, c);
+        out() << " -> " << scaling_ratio(A) << std::endl;
+        out() << "Row scale: " << row_scale;
+        out() << "Column scale: " << col_scale << std::endl;
+        // x' = S'x and s' = R*s
+        for(unsigned j=0; j<n; j++)
+            if(upper.at(0, j) < INF)
+                upper.at(0, j) /= col_scale.at(0, j);
+        for(unsigned i=0; i<m; i++)
+            if(upper.at(0, n+i) < INF)
+                upper.at(0, n+i) *= row_scale.at(0, i);
+        out() << "Scaled system:" << std::endl;
+        show_system(A, b, c);
+        out() << BAR << std::endl;
+    }
+
+    // work of engine is difference of thread counters (concurrent solve adds counters of winner in run)
+    m_row_scale = row_scale;
+    m_col_scale = col_scale;
+
+    m_counters = SimplexCounters();
+    auto before = ::counters();
+    m_status = run(A, b, c, upper);
+    m_dual_feasible = false;
+    m_counters = m_counters + (::counters() - before);
+    if(m_status == SolverStatus::OPTIMAL)
+        m_x = unscale_x(m_x, row_scale, col_scale);
+    else
+    {
+        m_x = Matrix();
+        m_P.clear();
+        m_Q.clear();
+    }
+    return m_status;
+}
+
+// Solves scaled system with chosen method, result is kept in m_F, m_x, m_P, m_Q and m_at_upper
+// Warm start: if base is set (set_basis or previous solve) simplex continues from it
+SolverStatus Solver::run(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper)
+{
+    auto n = A.width();
+    auto m = A.height();
+    auto cancelled = [&]() { return m_cancel != nullptr && m_cancel->load(); };
+
+    // Rezidual Simplex:
+    // P ~ column indexes of base matrix B
+    // Q ~ other column indexes
+    // (indexes 0..N-1 are structural and N..N+M-1 are logical columns)
+    // x ~ solution
+    // at_upper ~ true for nonbase variables at upper bound
+    bool warm = m_P.size() == m && m_at_upper.size() == n+m;
+    std::vector<unsigned> P, Q;
+    std::vector<bool> at_upper(n+m, false);
+    if(warm)
+    {
+        P = m_P;
+        Q = get_Q(P, n+m);
+        at_upper = m_at_upper;
+    }
+    double F = 0.0;
+    Matrix x;
+    bool solved = false;
+    // factorization of last base is used only by dual simplex of warm start below
+    std::optional<EtaFile> factorization;
+    factorization.swap(m_factorization);
+
+    // Barrier: interior point method, solution is not vertex unless crossover finds optimal base
+    // Crossover: base is found from barrier solution and simplex continues from it
+    if(m_method == SolverMethod::BARRIER)
+    {
+        out() << "Barrier (interior point method):" << std::endl;
+        // Ray without feasible x: system is infeasible or unbounded, simplex below decides (phase one)
+        BarrierStatus verdict = BarrierStatus::FAILED;
+        std::tie(F, x) = barrier(A, b, c, upper, m_threads, m_cancel, &verdict);
+        if(x.height() == 0 && x.width() == 0 && verdict != BarrierStatus::INFEASIBLE_OR_UNBOUNDED)
+        {
+            if(cancelled())
+                return SolverStatus::CANCELLED;
+            if(verdict == BarrierStatus::INFEASIBLE)
+                return SolverStatus::INFEASIBLE;
+            return (verdict == BarrierStatus::UNBOUNDED) ? SolverStatus::UNBOUNDED : SolverStatus::FAILED;
+        }
+        if(x.width() == 0)
+            out() << "Simplex decides if system is infeasible or unbounded." << std::endl;
+        else
+        {
+            solved = true;
+            P.clear();
+            Q.clear();
+        }
+
+        if(solved && m_crossover)
+        {
+            std::tie(P, Q) = crossover_basis(A, x, upper, at_upper);
+            out() << "Crossover base indexes(P): ";
+            vector_print(P);
+            solved = solve_from_basis(A, b, c, P, Q, upper, at_upper, F, x, m_cancel);
+            if(!solved)
+                out() << "Starting from scratch." << std::endl;
+        }
+        out() << BAR << std::endl;
+    }
+
+    // Concurrent: primal simplex, dual simplex and barrier race, first engine with verdict cancels others
+    // Output of every engine is kept separately and only output of winner is shown
+    if(m_method == SolverMethod::CONCURRENT)
+    {
+        auto[winner, results] = concurrent_solve(A, b, c, upper, m_threads, m_crossover);
+        out() << "Concurrent solve:" << std::endl;
+        for(unsigned k=0; k<results.size(); k++)
+        {
+            const auto& result = results.at(k);
+            out() << result.name << ": ";
+            if(result.optimal)
+                out() << "optimal";
+            else if(result.infeasible)
+                out() << "infeasible";
+            else if(result.unbounded)
+                out() << "unbounded";
+            else if(result.cancelled)
+                out() << "cancelled";
+            else
+                out() << "no solution";
+            if(k == winner)
+                out() << " (winner)";
+            out() << ", " << result.seconds*1000 << " ms" << std::endl;
+        }
+        out() << BAR << std::endl;
+        if(winner == STOP)
+        {
+            out() << "No engine found optimal solution (system is infeasible or unbounded)!" << std::endl;
+            return SolverStatus::FAILED;
+        }
+        auto& result = results.at(winner);
+        out() << "Output of " << result.name << ":" << std::endl;
+        out() << result.log;
+        out() << BAR << std::endl;
+        // Winner proved that system is infeasible (phase one or dual simplex) or unbounded (feasible ray)
+        if(result.infeasible || result.unbounded)
+        {
+            m_counters = result.counters;
+            out() << result.name << " found that " << (result.infeasible ? "system has no solution!" :
+                     "function does not reach optimal value!") << std::endl;
+            return result.infeasible ? SolverStatus::INFEASIBLE : SolverStatus::UNBOUNDED;
+        }
+        F = result.F;
+        x = result.x;
+        P = result.P;
+        Q = result.Q;
+        at_upper = result.at_upper;
+        m_counters = result.counters;
+        solved = true;
+    }
+
+    // Rows were added to optimal base (add_rows) or bounds were changed (set_bounds): base is dual
+    // feasible, so dual simplex continues from it without checking (only violated rows are pivoted)
+    if(!solved && warm && m_dual_feasible)
+    {
+        out() << "Base after new rows or bounds is dual feasible => " << (m_lexicographic ? "lexicographic " : "")
+              << "dual simplex, base indexes(P): ";
+        vector_print(P);
+        std::tie(F, x) = dual_simplex(A, b, c, P, Q, upper, at_upper, m_cancel, m_lexicographic, &factorization);
+        if(x.width() == 0)
+            return cancelled() ? SolverStatus::CANCELLED : SolverStatus::INFEASIBLE;
+        solved = true;
+        out() << BAR << std::endl;
+    }
+    else
+        factorization.reset();
+
+    // Warm start:
+    // If base is primal feasible (xb >= 0, ex. only c changed) then residual simplex continues from it
+    // If base is dual feasible (r >= 0 at lower and r <= 0 at upper bound, ex. only b changed) then dual simplex continues from it
+    // Otherwise we start from scratch
+    if(!solved && warm)
+    {
+        out() << "Starting base indexes(P): ";
+        vector_print(P);
+        auto status = get_basis_status(A, b, c, P, Q, upper, at_upper);
+        solved = solve_from_basis(A, b, c, P, Q, upper, at_upper, F, x, m_cancel);
+        if(solved && x.width() == 0)
+        {
+            if(cancelled())
+                return SolverStatus::CANCELLED;
+            return (status == BasisStatus::PRIMAL_FEASIBLE) ? SolverStatus::UNBOUNDED : SolverStatus::INFEASIBLE;
+        }
+        if(!solved)
+        {
+            out() << "Starting from scratch." << std::endl;
+            at_upper.assign(n+m, false);
+        }
+        out() << BAR << std::endl;
+    }
+
+    // Dual: slack base + dual simplex
+    if(!solved && m_method == SolverMethod::DUAL)
+    {
+        out() << "Dual simplex: " << std::endl;
+        // dual simplex without result ~ dual is unbounded (system is infeasible), unbounded ray is
+        // found only after artificial bounds are removed
+        auto result = dual_engine(A, b, c, upper, m_cancel);
+        if(!result.optimal)
+        {
+            if(cancelled())
+                return SolverStatus::CANCELLED;
+            return result.unbounded ? SolverStatus::UNBOUNDED : SolverStatus::INFEASIBLE;
+        }
+        F = result.F;
+        x = result.x;
+        P = result.P;
+        Q = result.Q;
+        at_upper = result.at_upper;
+        solved = true;
+    }
+
+    // Two-phase: phase one with artificial variables, phase two from base of phase one
+    // Composite: same artificial variables, cost is used together with infeasibility
+    if(!solved && (m_method == SolverMethod::TWO_PHASE || m_method == SolverMethod::COMPOSITE))
+    {
+        if(m_method == SolverMethod::TWO_PHASE)
+        {
+            out() << "Two-phase simplex: " << std::endl;
+            std::tie(F, x) = two_phase_simplex(A, b, c, P, Q, upper, at_upper, m_cancel);
+        }
+        else
+        {
+            out() << "Composite simplex: " << std::endl;
+            std::tie(F, x) = composite_simplex(A, b, c, P, Q, upper, at_upper, m_cancel);
+        }
+        if(x.height() == 0 && x.width() == 0)
+        {
+            if(cancelled())
+                return SolverStatus::CANCELLED;
+            return P.empty() ? SolverStatus::INFEASIBLE : SolverStatus::UNBOUNDED;
+        }
+        solved = true;
+    }
+
+    // Primal: crash base + residual simplex
+    // Crash base that is not repaired to feasible base is no proof of infeasibility, so phase one
+    // of two-phase simplex continues instead
+    if(!solved)
+    {
+        std::tie(P, Q) = crash_basis(A, b, upper, at_upper);
+        if(P.empty())
+        {
+            out() << "Crash base is not feasible => two-phase simplex: " << std::endl;
+            at_upper.assign(n+m, false);
+            std::tie(F, x) = two_phase_simplex(A, b, c, P, Q, upper, at_upper, m_cancel);
+            if(x.height() == 0 && x.width() == 0)
+            {
+                if(cancelled())
+                    return SolverStatus::CANCELLED;
+                return P.empty() ? SolverStatus::INFEASIBLE : SolverStatus::UNBOUNDED;
+            }
+        }
+        else
+        {
+            out() << "crash_basis:" << std::endl;
+            out() << "Base indexes(P): ";
+            vector_print(P);
+            out() << "Nonbase indexes(Q): ";
+            vector_print(Q);
+            out() << BAR << std::endl;
+
+            out() << "Residual simplex: " << std::endl;
+            std::tie(F, x) = residual_simplex(A, b, c, P, Q, upper, at_upper, m_cancel);
+            if(x.height() == 0 && x.width() == 0)
+                return cancelled() ? SolverStatus::CANCELLED : SolverStatus::UNBOUNDED;
+        }
+    }
+
+    // Lexicographic optimum: optimal vertex moves to lexicographically smallest optimal vertex
+    if(m_lexicographic && P.size() == m)
+    {
+        if(lexicographic_optimum(A, b, c, P, Q, upper, at_upper, x) > 0)
+            factorization.reset();
+        F = 0.0;
+        for(unsigned j=0; j<c.width(); j++)
+            F += c.at(0, j)*x.at(0, j);
+    }
+
+    m_F = F;
+    m_x = x;
+    m_P = P;
+    m_Q = Q;
+    m_at_upper = at_upper;
+    m_factorization = std::move(factorization);
+    return SolverStatus::OPTIMAL;
+}
+
+unsigned Solver::height() const
+{
+    return m_A.height();
+}
+
+unsigned Solver::width() const
+{
+    return m_A.width() + m_A.height();
+}
+
+SolverStatus Solver::status() const
+{
+    return m_status;
+}
+
+double Solver::objective() const
+{
+    double F = m_F + m_F_shift;
+    return (m_maximize ? -F : F) + m_c0;
+}
+
+// x(j) = offset(j) + direction(j)*x'(j) (- x''(j) for split free variable)
+std::vector<double> Solver::x() const
+{
+    std::vector<double> result;
+    if(m_status != SolverStatus::OPTIMAL)
+        return result;
+    for(unsigned j=0; j<m_cols; j++)
+    {
+        double value = m_offset.at(j) + m_direction.at(j)*m_x.at(0, j);
+        if(m_split.at(j) != STOP)
+            value -= m_x.at(0, m_split.at(j));
+        result.push_back(value);
+    }
+    return result;
+}
+
+std::vector<double> Solver::slacks() const
+{
+    std::vector<double> result;
+    if(m_status != SolverStatus::OPTIMAL)
+        return result;
+    for(unsigned i=0; i<m_rows; i++)
+        result.push_back((m_sense.at(i) == '=') ? 0.0 : m_x.at(0, m_A.width()+i));
+    return result;
+}
+
+// u*B = Cb for optimal base of system that is not scaled, rows with sense '>' were
+// multiplied by -1 and max c*x was solved as min (-c)*x so their signs are changed back
+std::vector<double> Solver::duals() const
+{
+    std::vector<double> result;
+    if(m_status != SolverStatus::OPTIMAL || m_P.empty())
+        return result;
+    auto u = LU(get_B(m_A, m_P)).solve_transposed(get_Cb(m_c, m_P));
+    for(unsigned i=0; i<m_rows; i++)
+    {
+        double value = u.at(0, i);
+        if(m_sense.at(i) == '>')
+            value = -value;
+        if(m_maximize)
+            value = -value;
+        result.push_back(value);
+    }
+    return result;
+}
+
+const Matrix& Solver::solution() const
+{
+    return m_x;
+}
+
+const std::vector<unsigned>& Solver::basis() const
+{
+    return m_P;
+}
+
+const std::vector<bool>& Solver::at_upper() const
+{
+    return m_at_upper;
+}
+
+Matrix Solver::tableau_row(unsigned i) const
+{
+    return tableau_rows({i}).front();
+}
+
+// rho = e(i)*B', row(j) = rho*K(j)
+std::vector<Matrix> Solver::tableau_rows(const std::vector<unsigned>& rows) const
+{
+    for(auto i: rows)
+        if(m_P.empty() || i >= m_P.size())
+            throw std::invalid_argument("There is no optimal base or row is out of range!");
+    std::vector<Matrix> result;
+    if(rows.empty())
+        return result;
+    LU lu(get_B(m_A, m_P));
+    for(auto i: rows)
+    {
+        Matrix e(1, m_P.size());
+        e.at(0, i) = 1.0;
+        auto rho = lu.solve_transposed(e);
+        Matrix row(1, width());
+        for(unsigned j=0; j<width(); j++)
+            row.at(0, j) = dot_column(m_A, rho, j);
+        result.push_back(row);
+    }
+    return result;
+}
+
+// u = Cb*B', row(j) = -r(j) = u*K(j) - c(j)
+Matrix Solver::objective_row() const
+{
+    if(m_P.empty())
+        throw std::invalid_argument("There is no optimal base!");
+    LU lu(get_B(m_A, m_P));
+    auto u = lu.solve_transposed(get_Cb(m_c, m_P));
+    Matrix row(1, width());
+    for(unsigned j=0; j<width(); j++)
+        row.at(0, j) = dot_column(m_A, u, j) - get_cost(m_c, j);
+    return row;
+}
+
+const SimplexCounters& Solver::counters() const
+{
+    return m_counters;
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#ifndef __LP_SOLVER__
+#define __LP_SOLVER__
+
+#include "concurrent.hpp"
+#include "lp_reader.hpp"
+
+// *LP SOLVER* (liblp)
+// Model (LPModel) is transformed to system Ax + s = b, 0 <= x <= u, (min) c*x:
+// l(j) > -inf             => x(j) = l(j) + x'(j), u'(j) = u(j) - l(j)
+// l(j) = -inf, u(j) < inf => x(j) = u(j) - x'(j), u'(j) = inf
+// l(j) = -inf, u(j) = inf => x(j) = x'(j) - x''(j) (free variable gets new column)
+// row with sense '>' is multiplied by -1, logical variable of row is 0 <= s(i) <= range(i)
+// (0 <= s(i) <= 0 for equations), max c*x is solved as min (-c)*x
+// All results (x, duals, objective) are given for original model.
+// Solver writes nothing unless log stream is given (set_log).
+
+enum class SolverMethod { PRIMAL, DUAL, TWO_PHASE, COMPOSITE, BARRIER, CONCURRENT };
+
+enum class SolverStatus { UNSOLVED, OPTIMAL, INFEASIBLE, UNBOUNDED, FAILED, CANCELLED };
+
+std::string to_string(SolverStatus status);
+
+class Solver {
+private:
+    // original model
+    unsigned m_cols = 0, m_rows = 0;
+    bool m_maximize = false;
+    double m_c0 = 0.0, m_F_shift = 0.0;
+    std::vector<double> m_offset, m_direction;
+    std::vector<unsigned> m_split;
+    std::vector<char> m_sense;
+
+    // system Ax + s = b (not scaled), upper has width N+M
+    Matrix m_A, m_b, m_c, m_upper;
+
+    // options
+    SolverMethod m_method = SolverMethod::PRIMAL;
+    bool m_scaling = true, m_crossover = false, m_lexicographic = false;
+    unsigned m_threads = 0;
+    const std::atomic<bool>* m_cancel = nullptr;
+    std::ostream* m_log = nullptr;
+
+    // result (x is not scaled and has width N+M)
+    SolverStatus m_status = SolverStatus::UNSOLVED;
+    double m_F = 0.0;
+    Matrix m_x;
+    std::vector<unsigned> m_P, m_Q;
+    std::vector<bool> m_at_upper;
+    // base is dual feasible for system (optimal base before add_rows or set_bounds), dual simplex continues from it
+    bool m_dual_feasible = false;
+    // factorization of scaled base after dual simplex (add_rows borders it by new rows) and scale factors
+    // it was made for, next solve keeps those scale factors so dual simplex doesn't factorize B again
+    std::optional<EtaFile> m_factorization;
+    Matrix m_row_scale, m_col_scale;
+    SimplexCounters m_counters;
+
+    SolverStatus run(const Matrix& A, const Matrix& b, const Matrix& c, const Matrix& upper);
+
+public:
+    Solver() = default;
+
+    // throws std::invalid_argument if some variable has lower bound above its upper bound
+    void load(const LPModel& model);
+
+    void set_method(SolverMethod method);
+    void set_scaling(bool scaling);
+    // barrier: simplex continues from base found from barrier solution
+    void set_crossover(bool crossover);
+    // optimal base is made lexicographically optimal (lexicographic_optimum, lib/simplex.hpp) after
+    // every solve and dual simplex after add_rows or set_bounds uses lexicographic ratio test, so
+    // cutting plane loop can't cycle on degenerate vertices (Gomory's finite convergence)
+    void set_lexicographic(bool lexicographic);
+    // threads for barrier factorization (0 ~ all cores)
+    void set_threads(unsigned threads);
+    // solve stops with CANCELLED status when flag is set
+    void set_cancel(const std::atomic<bool>* cancel);
+    // every step of solver is written to log (nullptr ~ no output)
+    void set_log(std::ostream* log);
+
+    // Warm start: next solve starts from base P (nonbase variables at upper bound are marked in at_upper)
+    // P and at_upper use columns of system (width() columns, logical column of row i is N+i)
+    void set_basis(const std::vector<unsigned>& P, const std::vector<bool>& at_upper);
+
+    // Changes bounds of original variable j to lower <= x(j) <= upper (branch and bound)
+    // Variable must have finite lower bound in loaded model (x(j) = l(j) + x'(j)), so only shift of b
+    // and u'(j) change: base is kept and optimal base usually stays dual feasible (c didn't change),
+    // next solve continues with dual simplex from it. Base is not dual feasible (next solve checks
+    // it first) when variable at upper bound gets upper = inf (it goes to lower bound) or when fixed
+    // nonbase variable (u'(j) = 0, never priced so r(j) can have any sign) gets u'(j) > 0
+    // throws std::invalid_argument if variable is not shifted by lower bound or lower is -inf or above upper
+    void set_bounds(unsigned j, double lower, double upper);
+
+    // Changes objective to c*x (max if maximize, c0 is kept), c has value for every original variable
+    // Base is kept: optimal base stays primal feasible (A, b and bounds didn't change), so next solve
+    // continues with primal simplex from it (feasibility pump)
+    // throws std::invalid_argument if size of c doesn't match
+    void set_objective(const std::vector<double>& c, bool maximize);
+
+    // Adds rows a(k)*x sense(k) rhs(k) to loaded model (a(k) has value for every original variable,
+    // sense is '<', '>' or '='), rows are transformed same as rows of load
+    // Optimal (or dual feasible) base is kept and logical variable of every new row enters base,
+    // so base stays regular (B is extended by unit column) and dual feasible (c didn't change):
+    // next solve continues with dual simplex from it (cutting planes, branch and bound)
+    // Rows are appended to A in place and factorization of base from last dual simplex is bordered
+    // by new rows, so B is not factorized again
+    // throws std::invalid_argument if sizes of rows don't match
+    void add_rows(const std::vector<std::vector<double> >& rows, const std::vector<char>& sense,
+                  const std::vector<double>& rhs);
+    // Removes rows (indexes of rows in model, other rows move up)
+    // If logical variable of every removed row is in base (row is not tight), base without those
+    // logical variables stays regular and optimal (their duals are 0), so solution is kept,
+    // otherwise base is dropped and next solve starts from scratch
+    void remove_rows(std::vector<unsigned> rows);
+
+    SolverStatus solve();
+
+    // size of system [A | E] (structural columns after transformation + one logical column per row)
+    unsigned height() const;
+    unsigned width() const;
+
+    SolverStatus status() const;
+    // c*x + c0 of original model
+    double objective() const;
+    // values of original variables
+    std::vector<double> x() const;
+    // values of logical variables (s(i) = b(i) - A(i)*x for '<' rows, A(i)*x - b(i) for '>' rows, 0 for '=')
+    std::vector<double> slacks() const;
+    // y(i) ~ change of objective per unit change of b(i) (empty if there is no base)
+    std::vector<double> duals() const;
+    // solution of system Ax + s = b (width N+M)
+    const Matrix& solution() const;
+    // optimal base, empty if there is no base (ex. barrier without crossover)
+    const std::vector<unsigned>& basis() const;
+    const std::vector<bool>& at_upper() const;
+    // row i of B'[A | E] for optimal base (width N+M), used for cuts
+    Matrix tableau_row(unsigned i) const;
+    // rows of B'[A | E] for optimal base (B is factorized once for all rows)
+    std::vector<Matrix> tableau_rows(const std::vector<unsigned>& rows) const;
+    // objective row of tableau for optimal base in same form as tableau rows (F + row*x = F0, so
+    // row = -r = (Cb*B')[A | E] - c, width N+M, c of system, so c*x is minimized), used for
+    // Gomory's cut of objective
+    Matrix objective_row() const;
+    // work of last solve (iterations, pivots, bound flips, factorizations of winner for concurrent solve)
+    const SimplexCounters& counters() const;
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include <iostream>
 #include "matrix.hpp"
+#include "sparse_matrix.hpp"
 
 int main()
 {
@@ -77,6 +78,32 @@ int main()
     std::cout << "Checking solution: " << std::endl;
     std::cout << ((H*x - b).norm1() < 0.000001) << std::endl;
 
+    std::cout << "LU decomposition:" << std::endl;
+    LU lu(H);
+    std::cout << lu.solve(b) << std::endl;
+    std::cout << ((H*lu.solve(b) - b).norm1() < 0.000001) << std::endl;
+    Matrix c(std::vector<std::vector<double> >{{6, -4, 27}});
+    std::cout << lu.solve_transposed(c) << std::endl;
+    std::cout << ((lu.solve_transposed(c)*H - c).norm1() < 0.000001) << std::endl;
+
+    std::cout << "Eta file (column 1 replaced):" << std::endl;
+    EtaFile eta(H);
+    Matrix a(std::vector<std::vector<double> >{{1},{0},{3}});
+    eta.update(1, eta.solve(a));
+    Matrix H2 = H;
+    for(unsigned i=0; i<H2.height(); i++)
+        H2.at(i, 1) = a.at(i, 0);
+    std::cout << eta.solve(b) << std::endl;
+    std::cout << ((H2*eta.solve(b) - b).norm1() < 0.000001) << std::endl;
+    std::cout << eta.solve_transposed(c) << std::endl;
+    std::cout << ((eta.solve_transposed(c)*H2 - c).norm1() < 0.000001) << std::endl;
+
+    std::cout << "Cholesky decomposition:" << std::endl;
+    Matrix HH = H.transpose()*H;
+    Cholesky cholesky(HH);
+    std::cout << cholesky.solve(b) << std::endl;
+    std::cout << ((HH*cholesky.solve(b) - b).norm1() < 0.000001) << std::endl;
+
     Matrix copy1 = F;
     Matrix copy2(F);
     std::cout << "Copying Matrix:" << std::endl;
@@ -93,5 +120,12 @@ int main()
     std::cout << C.remove_column(1) << std::endl;
     std::cout << C.remove_row(1) << std::endl;
 
+    std::cout << "Sparse matrix:" << std::endl;
+    SparseMatrix S(3, 3, {{0, 0, 2}, {2, 1, -1}, {0, 0, 1}, {1, 2, 4}, {2, 2, 0}});
+    std::cout << S << std::endl;
+    std::cout << S.nonzeros() << " " << S.at(0, 0) << " " << S.at(1, 1) << std::endl;
+    std::cout << S.to_dense() << std::endl;
+    std::cout << (SparseMatrix(S.to_dense()).to_dense() == S.to_dense()) << std::endl;
+
     return 0;
 }
\ No newline at end of file
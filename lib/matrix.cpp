@@ -1,4 +1,7 @@
 #include "matrix.hpp"
+#include <cmath>
+#include <thread>
+#include <algorithm>
 
 void Matrix::init(unsigned height, unsigned width, double value)
 {
@@ -345,6 +348,15 @@ void append(Matrix& A, const Matrix& B)
     A.m_width += tmp.m_width;
 }
 
+void append_row(Matrix& A, const std::vector<double>& row)
+{
+    if(A.m_width != row.size())
+        throw std::invalid_argument("Row must have same width as matrix!");
+
+    A.m_elements.push_back(row);
+    A.m_height++;
+}
+
 void swap_columns(Matrix& A, unsigned i, unsigned j)
 {
     for(unsigned k=0; k<A.height(); k++)
@@ -354,4 +366,355 @@ void swap_columns(Matrix& A, unsigned i, unsigned j)
 std::vector<std::vector<double> > Matrix::to_cpp_matrix() const
 {
     return m_elements;
-}
\ No newline at end of file
+}
+
+LU::LU(const Matrix& A)
+    : m_LU(A.to_cpp_matrix()), m_perm(A.height())
+{
+    if(A.height() != A.width())
+        throw std::invalid_argument("Only square matrix can be decomposed!");
+
+    m_size = A.height();
+    for(unsigned i=0; i<m_size; i++)
+        m_perm.at(i) = i;
+
+    for(unsigned k=0; k<m_size; k++)
+    {
+        // partial pivoting: row with largest absolute value in k-th column
+        unsigned pivot = k;
+        for(unsigned i=k+1; i<m_size; i++)
+            if(std::fabs(m_LU[i][k]) > std::fabs(m_LU[pivot][k]))
+                pivot = i;
+        if(std::fabs(m_LU[pivot][k]) < 1e-12)
+            throw std::invalid_argument("Given matrix is singular and LU decomposition can't be found!");
+        std::swap(m_LU[k], m_LU[pivot]);
+        std::swap(m_perm[k], m_perm[pivot]);
+
+        for(unsigned i=k+1; i<m_size; i++)
+        {
+            double coef = m_LU[i][k] /= m_LU[k][k];
+            if(coef == 0.0)
+                continue;
+            for(unsigned j=k+1; j<m_size; j++)
+                m_LU[i][j] -= coef*m_LU[k][j];
+        }
+    }
+}
+
+unsigned LU::size() const
+{
+    return m_size;
+}
+
+// Substitutions are column oriented: column j is used only if its value is not 0,
+// so right side with few non-zero values (ex. unit vector) is solved faster
+Matrix LU::solve(const Matrix& b) const
+{
+    if(b.width() != 1 || b.height() != m_size)
+        throw std::invalid_argument("Matrix b must have shape Nx1!");
+
+    // Ly = Pb (L has 1s on diagonal)
+    std::vector<double> y(m_size);
+    for(unsigned i=0; i<m_size; i++)
+        y[i] = b.at(m_perm[i], 0);
+    for(unsigned j=0; j<m_size; j++)
+    {
+        if(y[j] == 0.0)
+            continue;
+        for(unsigned i=j+1; i<m_size; i++)
+            y[i] -= m_LU[i][j]*y[j];
+    }
+    // Ux = y
+    for(unsigned j=m_size; j-->0;)
+    {
+        if(y[j] == 0.0)
+            continue;
+        y[j] /= m_LU[j][j];
+        for(unsigned i=0; i<j; i++)
+            y[i] -= m_LU[i][j]*y[j];
+    }
+    Matrix x(m_size, 1);
+    for(unsigned i=0; i<m_size; i++)
+        x.at(i, 0) = y[i];
+    return x;
+}
+
+Matrix LU::solve_transposed(const Matrix& c) const
+{
+    if(c.height() != 1 || c.width() != m_size)
+        throw std::invalid_argument("Matrix c must have shape 1xN!");
+
+    // xA = c <=> (A^T)x^T = c^T, A^T = U^T*L^T*P
+    // U^T*z = c^T
+    std::vector<double> z(m_size);
+    for(unsigned i=0; i<m_size; i++)
+        z[i] = c.at(0, i);
+    for(unsigned j=0; j<m_size; j++)
+    {
+        if(z[j] == 0.0)
+            continue;
+        z[j] /= m_LU[j][j];
+        for(unsigned i=j+1; i<m_size; i++)
+            z[i] -= m_LU[j][i]*z[j];
+    }
+    // L^T*w = z
+    for(unsigned j=m_size; j-->0;)
+    {
+        if(z[j] == 0.0)
+            continue;
+        for(unsigned i=0; i<j; i++)
+            z[i] -= m_LU[j][i]*z[j];
+    }
+    // x = w*P
+    Matrix x(1, m_size);
+    for(unsigned i=0; i<m_size; i++)
+        x.at(0, m_perm[i]) = z[i];
+    return x;
+}
+
+EtaFile::EtaFile(const Matrix& B0)
+    : m_lu(B0)
+{
+}
+
+unsigned EtaFile::size() const
+{
+    return m_lu.size() + m_borders.size();
+}
+
+unsigned EtaFile::etas() const
+{
+    return m_rows.size();
+}
+
+unsigned EtaFile::borders() const
+{
+    return m_borders.size();
+}
+
+void EtaFile::update(unsigned row, const Matrix& y)
+{
+    if(y.width() != 1 || y.height() != size() || row >= size())
+        throw std::invalid_argument("Matrix y must have shape Nx1!");
+    if(std::fabs(y.at(row, 0)) < 1e-12)
+        throw std::invalid_argument("Eta matrix is singular!");
+
+    std::vector<double> eta(size());
+    for(unsigned i=0; i<size(); i++)
+        eta[i] = y.at(i, 0);
+    m_rows.push_back(row);
+    m_etas.push_back(std::move(eta));
+}
+
+void EtaFile::add_row(const Matrix& a)
+{
+    if(a.height() != 1 || a.width() != size())
+        throw std::invalid_argument("Matrix a must have shape 1xN!");
+
+    std::vector<double> row(size());
+    for(unsigned i=0; i<size(); i++)
+        row[i] = a.at(0, i);
+    m_borders.push_back(std::make_pair(m_etas.size(), std::move(row)));
+}
+
+// x = Ek'*...*E1'*B0'*b, E' changes only value in its row and subtracts it from others:
+// x(r) = v(r)/y(r), x(i) = v(i) - y(i)*x(r)
+// Bordered row (added after eta matrices before it) gives next value: x(d) = b(d) - a*x(0..d-1)
+Matrix EtaFile::solve(const Matrix& b) const
+{
+    if(b.width() != 1 || b.height() != size())
+        throw std::invalid_argument("Matrix b must have shape Nx1!");
+
+    unsigned d = m_lu.size();
+    Matrix b0(d, 1);
+    for(unsigned i=0; i<d; i++)
+        b0.at(i, 0) = b.at(i, 0);
+    auto x0 = m_lu.solve(b0);
+    Matrix x(size(), 1);
+    for(unsigned i=0; i<d; i++)
+        x.at(i, 0) = x0.at(i, 0);
+    unsigned l = 0;
+    for(unsigned k=0; k<=m_etas.size(); k++)
+    {
+        for(; l<m_borders.size() && m_borders[l].first == k; l++, d++)
+        {
+            const auto& a = m_borders[l].second;
+            double value = b.at(d, 0);
+            for(unsigned i=0; i<d; i++)
+                value -= a[i]*x.at(i, 0);
+            x.at(d, 0) = value;
+        }
+        if(k == m_etas.size())
+            break;
+
+        unsigned r = m_rows[k];
+        const auto& eta = m_etas[k];
+        double value = x.at(r, 0)/eta[r];
+        if(value == 0.0)
+            continue;
+        for(unsigned i=0; i<eta.size(); i++)
+            if(i != r)
+                x.at(i, 0) -= eta[i]*value;
+        x.at(r, 0) = value;
+    }
+    return x;
+}
+
+// z = c*Ek'*...*E1', x*B0 = z, z*E' changes only value in row of eta:
+// z(r) = (c(r) - sum{c(i)*y(i) | i != r})/y(r)
+// Bordered row is removed in reverse order: x(d) = z(d), z(0..d-1) = z(0..d-1) - x(d)*a
+Matrix EtaFile::solve_transposed(const Matrix& c) const
+{
+    if(c.height() != 1 || c.width() != size())
+        throw std::invalid_argument("Matrix c must have shape 1xN!");
+
+    Matrix z = c;
+    unsigned d = size(), l = m_borders.size();
+    for(unsigned k=m_etas.size(); ; k--)
+    {
+        for(; l>0 && m_borders[l-1].first == k; l--)
+        {
+            const auto& a = m_borders[l-1].second;
+            d--;
+            double value = z.at(0, d);
+            if(value != 0.0)
+                for(unsigned i=0; i<d; i++)
+                    z.at(0, i) -= value*a[i];
+        }
+        if(k == 0)
+            break;
+
+        unsigned r = m_rows[k-1];
+        const auto& eta = m_etas[k-1];
+        double value = z.at(0, r);
+        for(unsigned i=0; i<eta.size(); i++)
+            if(i != r && eta[i] != 0.0)
+                value -= z.at(0, i)*eta[i];
+        z.at(0, r) = value/eta[r];
+    }
+    if(m_borders.empty())
+        return m_lu.solve_transposed(z);
+
+    Matrix z0(1, d);
+    for(unsigned i=0; i<d; i++)
+        z0.at(0, i) = z.at(0, i);
+    auto x0 = m_lu.solve_transposed(z0);
+    for(unsigned i=0; i<d; i++)
+        z.at(0, i) = x0.at(0, i);
+    return z;
+}
+
+// Runs f(i) for i in [begin, end), rows are interleaved between threads (i = begin + t, begin + t + threads, ...)
+// so threads get similar work for triangular loops
+static void parallel_rows(unsigned begin, unsigned end, unsigned threads, const std::function<void(unsigned)>& f)
+{
+    if(threads <= 1 || end - begin < 2*threads)
+    {
+        for(unsigned i=begin; i<end; i++)
+            f(i);
+        return;
+    }
+    std::vector<std::thread> pool;
+    for(unsigned t=0; t<threads; t++)
+        pool.emplace_back([=, &f]() {
+            for(unsigned i=begin+t; i<end; i+=threads)
+                f(i);
+        });
+    for(auto& thread: pool)
+        thread.join();
+}
+
+Cholesky::Cholesky(const Matrix& A, unsigned threads)
+    : m_L(A.to_cpp_matrix())
+{
+    if(A.height() != A.width())
+        throw std::invalid_argument("Only square matrix can be decomposed!");
+
+    m_size = A.height();
+    if(threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    if(m_size < CHOLESKY_PARALLEL)
+        threads = 1;
+
+    // L(i, j) -= sum L(i, p)*L(j, p) for p in [first, last)
+    auto update = [this](unsigned i, unsigned j, unsigned first, unsigned last) {
+        const double* Li = m_L[i].data();
+        const double* Lj = m_L[j].data();
+        double sum = 0.0;
+        for(unsigned p=first; p<last; p++)
+            sum += Li[p]*Lj[p];
+        m_L[i][j] -= sum;
+    };
+
+    const unsigned block = 64;
+    for(unsigned k0=0; k0<m_size; k0+=block)
+    {
+        unsigned k1 = std::min(k0 + block, m_size);
+
+        // Step1: diagonal block (previous blocks are already subtracted in Step3)
+        for(unsigned j=k0; j<k1; j++)
+        {
+            update(j, j, k0, j);
+            if(!(m_L[j][j] > 0.0))
+                throw std::invalid_argument("Given matrix is not positive definite and Cholesky decomposition can't be found!");
+            m_L[j][j] = std::sqrt(m_L[j][j]);
+            for(unsigned i=j+1; i<k1; i++)
+            {
+                update(i, j, k0, j);
+                m_L[i][j] /= m_L[j][j];
+            }
+        }
+
+        // Step2: panel below diagonal block (rows are independent)
+        parallel_rows(k1, m_size, threads, [&](unsigned i) {
+            for(unsigned j=k0; j<k1; j++)
+            {
+                update(i, j, k0, j);
+                m_L[i][j] /= m_L[j][j];
+            }
+        });
+
+        // Step3: trailing matrix: A(i, j) -= L(i, k0:k1)*L(j, k0:k1) for k1 <= j <= i
+        parallel_rows(k1, m_size, threads, [&](unsigned i) {
+            for(unsigned j=k1; j<=i; j++)
+                update(i, j, k0, k1);
+        });
+    }
+
+    // upper triangle is not part of L
+    for(unsigned i=0; i<m_size; i++)
+        for(unsigned j=i+1; j<m_size; j++)
+            m_L[i][j] = 0.0;
+}
+
+unsigned Cholesky::size() const
+{
+    return m_size;
+}
+
+Matrix Cholesky::solve(const Matrix& b) const
+{
+    if(b.width() != 1 || b.height() != m_size)
+        throw std::invalid_argument("Matrix b must have shape Nx1!");
+
+    // Ly = b
+    std::vector<double> y(m_size);
+    for(unsigned i=0; i<m_size; i++)
+    {
+        double value = b.at(i, 0);
+        for(unsigned j=0; j<i; j++)
+            value -= m_L[i][j]*y[j];
+        y[i] = value/m_L[i][i];
+    }
+    // L^T x = y
+    for(unsigned j=m_size; j-->0;)
+    {
+        y[j] /= m_L[j][j];
+        for(unsigned i=0; i<j; i++)
+            y[i] -= m_L[j][i]*y[j];
+    }
+    Matrix x(m_size, 1);
+    for(unsigned i=0; i<m_size; i++)
+        x.at(i, 0) = y[i];
+    return x;
+}
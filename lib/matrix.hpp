@@ -74,9 +74,86 @@ public:
     std::vector<std::vector<double> > to_cpp_matrix() const;
 
     friend void append(Matrix& A, const Matrix& B);
+    // row is added below last row of A (width must match)
+    friend void append_row(Matrix& A, const std::vector<double>& row);
     friend void swap_columns(Matrix& A, unsigned i, unsigned j);
 };
 
 Matrix identity(unsigned size);
 
+// LU decomposition with partial pivoting: P*A = L*U
+// Used to solve many systems with same matrix A without calculating inverse
+class LU {
+private:
+    std::vector<std::vector<double> > m_LU;
+    std::vector<unsigned> m_perm;
+    unsigned m_size;
+
+public:
+    // throws std::invalid_argument if A is singular
+    LU(const Matrix& A);
+
+    unsigned size() const;
+
+    // solves system: Ax = b (b has shape Nx1)
+    Matrix solve(const Matrix& b) const;
+    // solves system: xA = c (c has shape 1xN)
+    Matrix solve_transposed(const Matrix& c) const;
+};
+
+// Eta file (product form of base): B = B0*E1*E2*...*Ek
+// B0 is factorized with LU once, every column replacement adds eta matrix Ei
+// (identity with column row(i) replaced by y = B'a, a is new column), so B is not factorized again
+// New row a with unit column (B' = [B 0; a 1]) borders B: B'x = b <-> Bx1 = b1, x2 = b2 - a*x1
+class EtaFile {
+private:
+    LU m_lu;
+    std::vector<unsigned> m_rows;
+    std::vector<std::vector<double> > m_etas;
+    // bordered rows, first ~ number of eta matrices before row was added
+    std::vector<std::pair<unsigned, std::vector<double> > > m_borders;
+
+public:
+    // throws std::invalid_argument if B0 is singular
+    EtaFile(const Matrix& B0);
+
+    unsigned size() const;
+    // number of eta matrices
+    unsigned etas() const;
+    // number of bordered rows
+    unsigned borders() const;
+
+    // column row of B is replaced, y = B'a (solution of By = a for new column a)
+    // throws std::invalid_argument if y(row) is 0 (new B is singular)
+    void update(unsigned row, const Matrix& y);
+    // B is extended by row a (shape 1xN) and unit column: B' = [B 0; a 1] (size grows by 1)
+    void add_row(const Matrix& a);
+
+    // solves system: Bx = b (b has shape Nx1)
+    Matrix solve(const Matrix& b) const;
+    // solves system: xB = c (c has shape 1xN)
+    Matrix solve_transposed(const Matrix& c) const;
+};
+
+// Cholesky decomposition: A = L*L^T (A is symmetric positive definite, only lower triangle of A is used)
+// Factorization is blocked, for size >= CHOLESKY_PARALLEL panel and trailing matrix
+// of every block column are computed with multiple threads
+#define CHOLESKY_PARALLEL 256
+
+class Cholesky {
+private:
+    std::vector<std::vector<double> > m_L;
+    unsigned m_size;
+
+public:
+    // throws std::invalid_argument if A is not positive definite
+    // threads = 0 ~ std::thread::hardware_concurrency()
+    Cholesky(const Matrix& A, unsigned threads = 0);
+
+    unsigned size() const;
+
+    // solves system: Ax = b (b has shape Nx1)
+    Matrix solve(const Matrix& b) const;
+};
+
 #endif
\ No newline at end of file
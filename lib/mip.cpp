@@ -0,0 +1,730 @@
+#include "mip.hpp"
+#include <thread>
+
+std::string to_string(MipStatus status)
+{
+    switch(status)
+    {
+        case MipStatus::OPTIMAL:    return "optimal";
+        case MipStatus::GAP_LIMIT:  return "gap limit";
+        case MipStatus::TIME_LIMIT: return "time limit";
+        case MipStatus::NODE_LIMIT: return "node limit";
+        case MipStatus::INFEASIBLE: return "infeasible";
+        case MipStatus::UNBOUNDED:  return "unbounded";
+        case MipStatus::FAILED:     return "failed";
+    }
+    return "unknown";
+}
+
+// Node: bounds of original variables (only bounds of integer variables change), bound ~ LP value
+// of parent (min sign*c*x), P and at_upper ~ optimal base of parent
+struct Node {
+    unsigned long id = 0, parent = 0;
+    unsigned depth = 0;
+    double bound = -INF;
+    std::vector<double> lower, upper;
+    std::vector<unsigned> P;
+    std::vector<bool> at_upper;
+};
+
+// Queue of one worker, current ~ bound of node that worker solves (INF if it solves none),
+// so global bound = min(bounds of queued nodes, current of every worker)
+struct NodeQueue {
+    std::mutex mutex;
+    std::vector<Node> nodes;
+    double current = INF;
+};
+
+// index of node with smallest bound (nodes must not be empty)
+static unsigned best_node(const std::vector<Node>& nodes)
+{
+    unsigned best = 0;
+    for(unsigned k=1; k<nodes.size(); k++)
+        if(nodes.at(k).bound < nodes.at(best).bound)
+            best = k;
+    return best;
+}
+
+// heuristics (indexes of MipResult::heuristics)
+enum Heuristic { ROUNDING, PUMP, DIVING, GUIDED_DIVING, RENS };
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Search of tree: all values are for min sign*c*x (sign = -1 for max), incumbent ~ best integer solution
+class BranchAndBound {
+private:
+    const LPModel& m_model;
+    const MipOptions& m_options;
+    double m_sign;
+    std::chrono::steady_clock::time_point m_start;
+
+    // root relaxation (with cuts), every worker solves nodes with its own copy
+    Solver m_root;
+    std::vector<NodeQueue> m_queues;
+    // open ~ nodes in queues and nodes that workers solve, search ends when it is 0
+    std::atomic<unsigned long> m_open{0}, m_next_id{1}, m_nodes{0}, m_steals{0}, m_pivots{0};
+    std::atomic<unsigned> m_running{0};
+    std::atomic<bool> m_stop{false}, m_time_stop{false}, m_node_stop{false};
+
+    // incumbent and smallest bound of nodes pruned only by gap (they are not proven)
+    std::mutex m_incumbent_mutex;
+    std::atomic<double> m_incumbent{INF};
+    double m_pruned = INF;
+    std::vector<double> m_x;
+
+    std::mutex m_log_mutex;
+    std::mutex m_heuristics_mutex;
+    std::vector<HeuristicStats> m_heuristics;
+
+    double tolerance(double value) const
+    {
+        return std::max(m_options.gap, 1e-9)*std::max(1.0, std::fabs(value));
+    }
+
+    double gap(double incumbent, double bound) const
+    {
+        if(incumbent == INF)
+            return INF;
+        return std::max(0.0, incumbent - bound)/std::max(1.0, std::fabs(incumbent));
+    }
+
+    // Node is pruned if its bound can't improve incumbent by more than gap
+    // (nodes that are pruned only because of gap keep their bound in m_pruned)
+    bool prune(double bound)
+    {
+        double incumbent = m_incumbent;
+        if(bound < incumbent - tolerance(incumbent))
+            return false;
+        if(bound < incumbent - 1e-9*std::max(1.0, std::fabs(incumbent)))
+        {
+            std::lock_guard<std::mutex> lock(m_incumbent_mutex);
+            m_pruned = std::min(m_pruned, bound);
+        }
+        return true;
+    }
+
+    // min(bounds of open nodes, bounds of nodes pruned by gap), incumbent if there are none
+    double global_bound()
+    {
+        std::vector<std::unique_lock<std::mutex> > locks;
+        for(auto& queue: m_queues)
+            locks.emplace_back(queue.mutex);
+        double bound = INF;
+        for(auto& queue: m_queues)
+        {
+            bound = std::min(bound, queue.current);
+            for(const auto& node: queue.nodes)
+                bound = std::min(bound, node.bound);
+        }
+        locks.clear();
+        std::lock_guard<std::mutex> lock(m_incumbent_mutex);
+        return std::min({bound, m_pruned, m_incumbent.load()});
+    }
+
+    template<typename ... Values>
+    void log(const Values& ... values)
+    {
+        if(m_options.log == nullptr)
+            return;
+        std::lock_guard<std::mutex> lock(m_log_mutex);
+        ((*m_options.log) << ... << values) << std::endl;
+    }
+
+    void log_state(const std::string& head)
+    {
+        double incumbent = m_incumbent, bound = global_bound();
+        if(incumbent == INF && bound == INF)
+            log(head, "nodes: ", m_nodes.load(), ", open: ", m_open.load(), ", no incumbent, ", seconds_since(m_start), " s");
+        else if(incumbent == INF)
+            log(head, "nodes: ", m_nodes.load(), ", open: ", m_open.load(), ", bound: ", m_sign*bound,
+                ", no incumbent, ", seconds_since(m_start), " s");
+        else
+            log(head, "nodes: ", m_nodes.load(), ", open: ", m_open.load(), ", incumbent: ", m_sign*incumbent,
+                ", bound: ", m_sign*bound, ", gap: ", 100*gap(incumbent, bound), "%, ", seconds_since(m_start), " s");
+    }
+
+    // search stops if gap of incumbent and global bound is small enough
+    void check_gap()
+    {
+        double incumbent = m_incumbent;
+        if(incumbent != INF && gap(incumbent, global_bound()) <= m_options.gap)
+        {
+            m_stop = true;
+        }
+    }
+
+    // integer variables are rounded, objective is computed again for rounded x
+    // Returns true if x is new incumbent (source ~ who found it, written to log)
+    bool update_incumbent(std::vector<double> x, const std::string& source)
+    {
+        double F = m_model.c0;
+        for(unsigned j=0; j<x.size(); j++)
+        {
+            if(m_model.is_integer.at(j))
+                x.at(j) = std::round(x.at(j));
+            F += m_model.c.at(j)*x.at(j);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_incumbent_mutex);
+            if(m_sign*F >= m_incumbent)
+                return false;
+            m_incumbent = m_sign*F;
+            m_x = x;
+        }
+        log_state("Incumbent (" + source + "): ");
+        check_gap();
+        return true;
+    }
+
+    std::string source(const Node& node, unsigned worker) const
+    {
+        return "node " + std::to_string(node.id) + ", depth " + std::to_string(node.depth)
+               + ", thread " + std::to_string(worker);
+    }
+
+    // Heuristic gives solution (returns true if it found one), its work is counted in m_heuristics
+    template<typename Function>
+    void run_heuristic(Heuristic heuristic, const std::string& where, Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<double> solution;
+        bool found = function(solution);
+        bool improved = found && update_incumbent(solution, m_heuristics.at(heuristic).name + ", " + where);
+        std::lock_guard<std::mutex> lock(m_heuristics_mutex);
+        auto& stats = m_heuristics.at(heuristic);
+        stats.calls++;
+        stats.found += found;
+        stats.improved += improved;
+        stats.seconds += seconds_since(start);
+    }
+
+    // Heuristics at node with fractional LP solution x: simple rounding, after every
+    // HEURISTIC_FREQUENCY nodes diving (guided by incumbent if there is one)
+    void node_heuristics(const Node& node, const Solver& solver, const std::vector<double>& x, unsigned worker)
+    {
+        run_heuristic(ROUNDING, source(node, worker), [&](std::vector<double>& solution)
+        {
+            return simple_rounding(m_model, x, solution);
+        });
+        if(m_nodes % HEURISTIC_FREQUENCY != 0)
+            return;
+        std::vector<double> guide;
+        {
+            std::lock_guard<std::mutex> lock(m_incumbent_mutex);
+            guide = m_x;
+        }
+        Heuristic heuristic = guide.empty() ? DIVING : GUIDED_DIVING;
+        run_heuristic(heuristic, source(node, worker), [&](std::vector<double>& solution)
+        {
+            return ::dive(m_model, solver, node.lower, node.upper, guide.empty() ? DiveRule::FRACTIONAL : DiveRule::GUIDED,
+                          guide, m_incumbent, solution);
+        });
+    }
+
+    // Root heuristics: simple rounding, feasibility pump (only if there is no incumbent),
+    // fractional diving and RENS
+    void root_heuristics(const Node& root)
+    {
+        auto x = m_root.x();
+        run_heuristic(ROUNDING, "root", [&](std::vector<double>& solution)
+        {
+            return simple_rounding(m_model, x, solution);
+        });
+        if(m_incumbent == INF)
+            run_heuristic(PUMP, "root", [&](std::vector<double>& solution)
+            {
+                return feasibility_pump(m_model, m_root, root.lower, root.upper, solution);
+            });
+        run_heuristic(DIVING, "root", [&](std::vector<double>& solution)
+        {
+            return ::dive(m_model, m_root, root.lower, root.upper, DiveRule::FRACTIONAL, {}, m_incumbent, solution);
+        });
+        run_heuristic(RENS, "root", [&](std::vector<double>& solution)
+        {
+            return rens(m_model, x, root.lower, root.upper, solution);
+        });
+    }
+
+    // Node is solved: integer x is new incumbent, otherwise variable with most fractional value
+    // (phi closest to 0.5) is branched: x(j) <= floor(x(j)) and x(j) >= ceil(x(j)),
+    // child on side of rounding is pushed last (worker continues with it)
+    // Integer x whose rounding violates rows of model (x(j) within EPS of integer r, but row has
+    // large coefficient) is not incumbent: variable that is not fixed in node and is farthest from
+    // r is branched to x(j) <= r - 1, x(j) = r and x(j) >= r + 1 (x(j) = r is pushed last),
+    // node with every integer variable fixed has no integer solution
+    // Returns true if children were pushed to queue of worker
+    bool branch(const Node& node, const Solver& solver, unsigned worker)
+    {
+        double value = m_sign*solver.objective();
+        if(prune(value))
+            return false;
+
+        auto x = solver.x();
+        unsigned j = STOP;
+        double best = 0.0;
+        for(unsigned k=0; k<x.size(); k++)
+        {
+            double fraction = phi(x.at(k));
+            if(m_model.is_integer.at(k) && std::min(fraction, 1 - fraction) > best)
+            {
+                best = std::min(fraction, 1 - fraction);
+                j = k;
+            }
+        }
+        // bounds of x(j) in children, last child is solved next by worker
+        std::vector<std::pair<double, double> > sides;
+        if(j == STOP)
+        {
+            auto rounded = x;
+            for(unsigned k=0; k<x.size(); k++)
+                if(m_model.is_integer.at(k))
+                    rounded.at(k) = std::round(x.at(k));
+            if(is_feasible(m_model, rounded))
+            {
+                update_incumbent(x, source(node, worker));
+                return false;
+            }
+            best = -1.0;
+            for(unsigned k=0; k<x.size(); k++)
+                if(m_model.is_integer.at(k) && node.lower.at(k) < node.upper.at(k) &&
+                   std::fabs(x.at(k) - rounded.at(k)) > best)
+                {
+                    best = std::fabs(x.at(k) - rounded.at(k));
+                    j = k;
+                }
+            if(j == STOP)
+                return false;
+            double r = rounded.at(j);
+            if(r - 1 >= node.lower.at(j))
+                sides.push_back(std::make_pair(node.lower.at(j), r - 1));
+            if(r + 1 <= node.upper.at(j))
+                sides.push_back(std::make_pair(r + 1, node.upper.at(j)));
+            sides.push_back(std::make_pair(r, r));
+        }
+        else
+        {
+            if(m_options.heuristics && node.depth > 0)
+                node_heuristics(node, solver, x, worker);
+            if(prune(value))
+                return false;
+            auto down = std::make_pair(node.lower.at(j), std::floor(x.at(j)));
+            auto up = std::make_pair(std::ceil(x.at(j)), node.upper.at(j));
+            if(phi(x.at(j)) >= 0.5)
+                sides = {down, up};
+            else
+                sides = {up, down};
+        }
+
+        auto& queue = m_queues.at(worker);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for(const auto& [lower, upper]: sides)
+        {
+            Node child;
+            child.id = m_next_id++;
+            child.parent = node.id;
+            child.depth = node.depth + 1;
+            child.bound = value;
+            child.lower = node.lower;
+            child.upper = node.upper;
+            child.lower.at(j) = lower;
+            child.upper.at(j) = upper;
+            child.P = solver.basis();
+            child.at_upper = solver.at_upper();
+            queue.nodes.push_back(std::move(child));
+            m_open++;
+        }
+        return true;
+    }
+
+    // Next node of worker: last pushed node while worker dives (child of node it just solved),
+    // otherwise node with smallest bound of its queue, if queue is empty then node with smallest
+    // bound of longest queue of other workers (work stealing)
+    bool take(unsigned worker, bool dive, Node& node)
+    {
+        auto& own = m_queues.at(worker);
+        {
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if(!own.nodes.empty())
+            {
+                unsigned k = dive ? own.nodes.size() - 1 : best_node(own.nodes);
+                node = std::move(own.nodes.at(k));
+                own.nodes.at(k) = std::move(own.nodes.back());
+                own.nodes.pop_back();
+                own.current = node.bound;
+                return true;
+            }
+        }
+
+        unsigned victim = STOP, longest = 0;
+        for(unsigned w=0; w<m_queues.size(); w++)
+        {
+            if(w == worker)
+                continue;
+            std::lock_guard<std::mutex> lock(m_queues.at(w).mutex);
+            if(m_queues.at(w).nodes.size() > longest)
+            {
+                longest = m_queues.at(w).nodes.size();
+                victim = w;
+            }
+        }
+        if(victim == STOP)
+            return false;
+
+        // both queues are locked, so node is always counted by global_bound
+        auto& other = m_queues.at(victim);
+        std::scoped_lock lock(own.mutex, other.mutex);
+        if(other.nodes.empty())
+            return false;
+        unsigned k = best_node(other.nodes);
+        node = std::move(other.nodes.at(k));
+        other.nodes.at(k) = std::move(other.nodes.back());
+        other.nodes.pop_back();
+        own.current = node.bound;
+        m_steals++;
+        return true;
+    }
+
+    // Solves node with solver of worker (lower and upper ~ bounds that solver has,
+    // last ~ id of node whose optimal base solver has)
+    // Bounds are changed with set_bounds, so if solver has optimal base of parent (dive) dual
+    // simplex continues from it, otherwise base of parent is set
+    bool process(const Node& node, Solver& solver, std::vector<double>& lower, std::vector<double>& upper,
+                 unsigned long& last, unsigned worker)
+    {
+        if(prune(node.bound))
+            return false;
+        for(unsigned j=0; j<lower.size(); j++)
+            if(node.lower.at(j) != lower.at(j) || node.upper.at(j) != upper.at(j))
+            {
+                solver.set_bounds(j, node.lower.at(j), node.upper.at(j));
+                lower.at(j) = node.lower.at(j);
+                upper.at(j) = node.upper.at(j);
+            }
+        if(node.parent != last)
+            solver.set_basis(node.P, node.at_upper);
+
+        auto status = solver.solve();
+        m_nodes++;
+        m_pivots += solver.counters().pivots;
+        last = (status == SolverStatus::OPTIMAL) ? node.id : 0;
+        if(status != SolverStatus::OPTIMAL)
+            return false;
+        return branch(node, solver, worker);
+    }
+
+    void work(unsigned worker)
+    {
+        Solver solver = m_root;
+        solver.set_cancel(&m_stop);
+        std::vector<double> lower = m_model.lower, upper = m_model.upper;
+        // every copy has optimal base of root (node 1)
+        unsigned long last = 1;
+        bool dive = false;
+        while(!m_stop)
+        {
+            Node node;
+            if(!take(worker, dive, node))
+            {
+                if(m_open == 0)
+                    break;
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                continue;
+            }
+            dive = process(node, solver, lower, upper, last, worker);
+
+            // node that was cancelled stays open (its bound is kept in current)
+            if(solver.status() != SolverStatus::CANCELLED)
+            {
+                std::lock_guard<std::mutex> lock(m_queues.at(worker).mutex);
+                m_queues.at(worker).current = INF;
+                m_open--;
+            }
+            unsigned long nodes = m_nodes;
+            if(m_options.time_limit > 0.0 && seconds_since(m_start) > m_options.time_limit)
+            {
+                m_time_stop = true;
+                m_stop = true;
+            }
+            if(m_options.node_limit > 0 && nodes >= m_options.node_limit)
+            {
+                m_node_stop = true;
+                m_stop = true;
+            }
+            if(nodes % MIP_GAP_NODES == 0)
+                check_gap();
+            if(nodes % MIP_LOG_NODES == 0)
+                log_state("");
+        }
+        m_running--;
+    }
+
+public:
+    BranchAndBound(const LPModel& model, const MipOptions& options, const Solver& root, unsigned threads)
+        : m_model(model), m_options(options), m_sign(model.maximize ? -1.0 : 1.0),
+          m_start(std::chrono::steady_clock::now()), m_root(root), m_queues(threads)
+    {
+        m_root.set_cancel(&m_stop);
+        for(auto name: {"simple rounding", "feasibility pump", "fractional diving", "guided diving", "RENS"})
+        {
+            m_heuristics.emplace_back();
+            m_heuristics.back().name = name;
+        }
+    }
+
+    // Root node (solved in root) is branched by worker 0, workers search tree until there are no open
+    // nodes or search is stopped, time limit is checked also while workers solve LPs (cancel flag)
+    MipResult search(MipResult result)
+    {
+        Node root;
+        root.id = m_next_id++;
+        root.lower = m_model.lower;
+        root.upper = m_model.upper;
+        root.bound = m_sign*m_root.objective();
+        m_open = 1;
+        m_queues.at(0).current = root.bound;
+        if(m_options.heuristics)
+            root_heuristics(root);
+        branch(root, m_root, 0);
+        m_queues.at(0).current = INF;
+        m_open--;
+
+        std::vector<std::thread> threads;
+        m_running = m_queues.size();
+        for(unsigned w=0; w<m_queues.size(); w++)
+            threads.emplace_back(&BranchAndBound::work, this, w);
+        while(m_running > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            if(m_options.time_limit > 0.0 && seconds_since(m_start) > m_options.time_limit)
+            {
+                m_time_stop = true;
+                m_stop = true;
+            }
+        }
+        for(auto& thread: threads)
+            thread.join();
+
+        double incumbent = m_incumbent, bound = global_bound();
+        result.nodes = m_nodes;
+        result.steals = m_steals;
+        result.pivots += m_pivots;
+        result.threads = m_queues.size();
+        result.x = m_x;
+        result.heuristics = m_heuristics;
+        if(incumbent != INF)
+        {
+            result.objective = m_sign*incumbent;
+            result.gap = gap(incumbent, bound);
+        }
+        result.bound = (bound == INF) ? m_sign*LP_INF : m_sign*bound;
+        if(m_time_stop)
+            result.status = MipStatus::TIME_LIMIT;
+        else if(m_node_stop)
+            result.status = MipStatus::NODE_LIMIT;
+        else if(incumbent == INF)
+            result.status = MipStatus::INFEASIBLE;
+        else
+            result.status = (bound < incumbent - 1e-9*std::max(1.0, std::fabs(incumbent))) ? MipStatus::GAP_LIMIT : MipStatus::OPTIMAL;
+        if(result.status == MipStatus::TIME_LIMIT || result.status == MipStatus::NODE_LIMIT)
+            log_state((result.status == MipStatus::TIME_LIMIT) ? "Time limit, " : "Node limit, ");
+        else
+            log_state((result.status == MipStatus::GAP_LIMIT) ? "Gap limit, " : "Search ended, ");
+        return result;
+    }
+};
+
+// Gomory's fractional cuts are valid for pure integer problem with x >= 0 and integer A, b (lib/cuts.hpp)
+static bool gomory_applicable(const LPModel& model, const std::vector<std::vector<double> >& A)
+{
+    for(unsigned j=0; j<model.cols(); j++)
+        if(!model.is_integer.at(j) || model.lower.at(j) != 0.0 || !std::isinf(model.upper.at(j)))
+            return false;
+    for(unsigned i=0; i<model.rows(); i++)
+    {
+        if(!std::isinf(model.range.at(i)) || phi(model.rhs.at(i)) != 0.0)
+            return false;
+        for(auto value: A.at(i))
+            if(phi(value) != 0.0)
+                return false;
+    }
+    return true;
+}
+
+MipResult branch_and_bound(const LPModel& model, const MipOptions& options)
+{
+    auto start = std::chrono::steady_clock::now();
+    MipResult result;
+    double sign = model.maximize ? -1.0 : 1.0;
+    auto log = [&](auto... values)
+    {
+        if(options.log)
+            ((*options.log) << ... << values) << std::endl;
+    };
+    auto finish = [&](MipStatus status)
+    {
+        result.status = status;
+        result.seconds = seconds_since(start);
+        log("Status: ", to_string(status));
+        return result;
+    };
+
+    // Step1: bounds of integer variables are rounded (l = ceil(l), u = floor(u)), every integer
+    // variable needs finite lower bound (set_bounds changes shift of x(j) = l(j) + x'(j))
+    LPModel integer_model = model;
+    for(unsigned j=0; j<model.cols(); j++)
+    {
+        if(!model.is_integer.at(j))
+            continue;
+        if(std::isinf(model.lower.at(j)))
+            throw std::invalid_argument("Integer variable " + model.col_names.at(j) + " needs lower bound!");
+        integer_model.lower.at(j) = std::ceil(model.lower.at(j) - EPS);
+        if(!std::isinf(model.upper.at(j)))
+            integer_model.upper.at(j) = std::floor(model.upper.at(j) + EPS);
+        if(integer_model.lower.at(j) > integer_model.upper.at(j))
+            return finish(MipStatus::INFEASIBLE);
+    }
+
+    // Step2: root relaxation (not scaled, so tableau rows for cuts have original values)
+    Solver root;
+    root.load(integer_model);
+    root.set_scaling(false);
+    auto status = root.solve();
+    result.pivots += root.counters().pivots;
+    if(status == SolverStatus::INFEASIBLE)
+        return finish(MipStatus::INFEASIBLE);
+    if(status == SolverStatus::UNBOUNDED)
+        return finish(MipStatus::UNBOUNDED);
+    if(status != SolverStatus::OPTIMAL)
+        return finish(MipStatus::FAILED);
+    result.root = root.objective();
+    log("Root relaxation: ", result.root, " (", root.counters().pivots, " pivots)");
+
+    // Step3: rounds of cuts at root: in every round each family (options.cut_families) separates
+    // candidates for x, filter_cuts and select_cuts choose best of them, they are added to root
+    // relaxation and dual simplex continues from optimal base, so next family separates new x and
+    // gain of bound is counted for family that added cuts; rounds stop when bound doesn't improve
+    // (cuts stay in relaxation of every node)
+    // GOMORY needs pure integer problem with x >= 0 and integer A, b and logical variables of cut rows
+    // that are integer (rows with GMI or MIR cut are skipped), GMI needs bound for every variable
+    auto A = integer_model.A.to_dense().to_cpp_matrix();
+    bool gomory = gomory_applicable(integer_model, A), bounded = true;
+    for(unsigned j=0; j<model.cols(); j++)
+        bounded = bounded && !(std::isinf(integer_model.lower.at(j)) && std::isinf(integer_model.upper.at(j)));
+    for(auto family: options.cut_families)
+        result.cut_stats.push_back(CutStats{family});
+    if(options.cuts && !options.cut_families.empty())
+    {
+        std::vector<double> b = integer_model.rhs;
+        std::vector<char> sense = integer_model.sense;
+        std::vector<bool> integral(model.rows(), true);
+        std::vector<Cut> active;
+        for(unsigned round=1; round<=ROOT_CUT_ROUNDS; round++)
+        {
+            double round_start = sign*root.objective();
+            unsigned added = 0;
+            for(auto& stats: result.cut_stats)
+            {
+                auto family_start = std::chrono::steady_clock::now();
+                auto x = root.x();
+                std::vector<Cut> candidates;
+                if(stats.family == CutFamily::MIR)
+                    candidates = mir_cuts(integer_model, x);
+                else if(stats.family == CutFamily::COVER)
+                    candidates = cover_cuts(integer_model, x);
+                else if((stats.family == CutFamily::GOMORY && gomory) || (stats.family == CutFamily::GMI && bounded))
+                {
+                    // rows of tableau whose base variable is integer and fractional
+                    const auto& P = root.basis();
+                    const auto& solution = root.solution();
+                    std::vector<unsigned> rows;
+                    for(unsigned k=0; k<P.size(); k++)
+                        if(P.at(k) < model.cols() && integer_model.is_integer.at(P.at(k)) && phi(x.at(P.at(k))) > 0.0)
+                            rows.push_back(k);
+                    auto tableau = root.tableau_rows(rows);
+                    for(unsigned k=0; k<rows.size(); k++)
+                    {
+                        const auto& row = tableau.at(k);
+                        Cut cut;
+                        if(stats.family == CutFamily::GMI)
+                        {
+                            if(gmi_cut(row, solution.at(0, P.at(rows.at(k))), P, root.at_upper(), integer_model, A, b, sense, cut))
+                                candidates.push_back(cut);
+                            continue;
+                        }
+                        bool valid = true;
+                        for(unsigned i=0; i<A.size(); i++)
+                            valid = valid && (integral.at(i) || phi(row.at(0, model.cols()+i)) == 0.0);
+                        if(!valid)
+                            continue;
+                        if(!gomory_cut(row, x.at(P.at(rows.at(k))), P, A, b, sense, cut))
+                            return finish(MipStatus::INFEASIBLE);
+                        candidates.push_back(cut);
+                    }
+                }
+                else
+                    continue;
+                stats.rounds++;
+                stats.candidates += candidates.size();
+                filter_cuts(candidates, x);
+                stats.filtered += candidates.size();
+                auto chosen = select_cuts(candidates, x, active, CUTS_PER_ROUND);
+                if(chosen.empty())
+                {
+                    stats.seconds += seconds_since(family_start);
+                    continue;
+                }
+
+                std::vector<std::vector<double> > cut_rows;
+                std::vector<double> cut_rhs;
+                for(auto k: chosen)
+                {
+                    const auto& cut = candidates.at(k);
+                    // logical variable of cut row is integer for Gomory's cut and cut with integer data
+                    bool integer = cut.family == CutFamily::GOMORY || phi(cut.rhs) == 0.0;
+                    for(auto value: cut.a)
+                        integer = integer && phi(value) == 0.0;
+                    active.push_back(cut);
+                    cut_rows.push_back(cut.a);
+                    cut_rhs.push_back(cut.rhs);
+                    A.push_back(cut.a);
+                    b.push_back(cut.rhs);
+                    sense.push_back('>');
+                    integral.push_back(integer);
+                }
+                double before = sign*root.objective();
+                root.add_rows(cut_rows, std::vector<char>(chosen.size(), '>'), cut_rhs);
+                status = root.solve();
+                result.pivots += root.counters().pivots;
+                if(status != SolverStatus::OPTIMAL)
+                    return finish(MipStatus::INFEASIBLE);
+                added += chosen.size();
+                result.cuts += chosen.size();
+                stats.added += chosen.size();
+                stats.gain += sign*root.objective() - before;
+                stats.seconds += seconds_since(family_start);
+            }
+            if(added == 0)
+                break;
+            double after = sign*root.objective();
+            log("Cut round ", round, ": ", added, " cuts, bound: ", root.objective());
+            if(after - round_start < ROOT_CUT_MIN_GAIN*std::max(1.0, std::fabs(round_start)))
+                break;
+        }
+        for(const auto& stats: result.cut_stats)
+            if(stats.rounds > 0)
+                log("Cuts ", to_string(stats.family), ": ", stats.candidates, " candidates, ", stats.filtered,
+                    " passed filter, ", stats.added, " added, bound gain ", stats.gain);
+    }
+
+    // Step4: tree search with worker threads
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    log("Branch and bound: ", threads, " threads");
+    BranchAndBound tree(integer_model, options, root, threads);
+    result = tree.search(result);
+    result.seconds = seconds_since(start);
+    log("Status: ", to_string(result.status));
+    return result;
+}
\ No newline at end of file
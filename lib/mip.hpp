@@ -0,0 +1,78 @@
+#ifndef __MIP__
+#define __MIP__
+
+#include "heuristics.hpp"
+#include <mutex>
+
+// *BRANCH AND BOUND* (liblp)
+// Mixed integer problem: LPModel with x(j) integer for is_integer(j), every integer variable needs
+// finite lower bound (branching changes bounds with Solver::set_bounds)
+// Node ~ LP relaxation with changed bounds of integer variables, its bound is LP value of parent
+// Worker threads have their own Solver (copy of root relaxation) and their own queue of nodes:
+// - depth-first: after branching worker continues with child on side of rounding (x(j) >= ceil
+//   for phi(x(j)) >= 0.5), child LP continues with dual simplex from optimal base of parent
+// - best-bound: when dive ends (node is pruned, infeasible or integer) worker takes node with
+//   smallest bound of its queue, base of that node's parent is set (set_basis)
+// - work stealing: worker with empty queue takes node with smallest bound from longest queue
+// Heuristics (lib/heuristics.hpp) give incumbents before tree finds them: at root simple rounding,
+// feasibility pump (if there is no incumbent yet), fractional diving and RENS, at nodes simple
+// rounding of every LP solution and diving from every HEURISTIC_FREQUENCY-th node (guided by
+// incumbent if there is one)
+// All results (objective, bound, x) are given for original model.
+
+// rounds of cuts at root (every round runs all cut families of MipOptions)
+#define ROOT_CUT_ROUNDS 10
+// cut rounds stop when root bound improves less than ROOT_CUT_MIN_GAIN*max(1, |bound|)
+#define ROOT_CUT_MIN_GAIN 1e-6
+// progress line is written to log after every MIP_LOG_NODES nodes
+#define MIP_LOG_NODES 1000
+// global bound (and gap) is checked after every MIP_GAP_NODES nodes and every new incumbent
+#define MIP_GAP_NODES 64
+// diving from node after every HEURISTIC_FREQUENCY nodes
+#define HEURISTIC_FREQUENCY 100
+
+enum class MipStatus { OPTIMAL, GAP_LIMIT, TIME_LIMIT, NODE_LIMIT, INFEASIBLE, UNBOUNDED, FAILED };
+
+std::string to_string(MipStatus status);
+
+struct MipOptions {
+    // worker threads (0 ~ all cores)
+    unsigned threads = 0;
+    // seconds (0 ~ no limit), search stops with best integer solution found so far
+    double time_limit = 0.0;
+    // search stops when (incumbent - bound)/max(1, |incumbent|) <= gap
+    double gap = 1e-4;
+    // search stops after node_limit nodes (0 ~ no limit)
+    unsigned long node_limit = 0;
+    // cuts at root and their families in order of separation (lib/cuts.hpp), fractional Gomory's
+    // cuts are dominated by GMI cuts of same rows, so they are not in default list
+    bool cuts = true;
+    std::vector<CutFamily> cut_families = {CutFamily::COVER, CutFamily::MIR, CutFamily::GMI};
+    // primal heuristics at root and nodes
+    bool heuristics = true;
+    // root, new incumbents and progress (nullptr ~ no output)
+    std::ostream* log = nullptr;
+};
+
+struct MipResult {
+    MipStatus status = MipStatus::FAILED;
+    // best integer solution (x is empty if none was found) and bound of optimal value
+    double objective = 0.0, bound = 0.0, gap = INF;
+    std::vector<double> x;
+    // root: LP value before cuts, cuts added to root relaxation
+    double root = 0.0;
+    unsigned cuts = 0;
+    // candidates, added cuts and bound gain of every cut family
+    std::vector<CutStats> cut_stats;
+    // nodes solved, nodes taken from queue of other worker, pivots of all LPs
+    unsigned long nodes = 0, steals = 0, pivots = 0;
+    unsigned threads = 0;
+    double seconds = 0.0;
+    // calls, solutions and improved incumbents of every heuristic
+    std::vector<HeuristicStats> heuristics;
+};
+
+// throws std::invalid_argument if integer variable has no lower bound or bounds are invalid
+MipResult branch_and_bound(const LPModel& model, const MipOptions& options = MipOptions());
+
+#endif
\ No newline at end of file
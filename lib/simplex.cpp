@@ -0,0 +1,1612 @@
+#include "simplex.hpp"
+
+static thread_local std::ostream* output = &std::cout;
+
+std::ostream& out()
+{
+    return *output;
+}
+
+void set_output(std::ostream& stream)
+{
+    output = &stream;
+}
+
+static thread_local SimplexCounters thread_counters;
+
+SimplexCounters& counters()
+{
+    return thread_counters;
+}
+
+SimplexCounters operator+(const SimplexCounters& a, const SimplexCounters& b)
+{
+    SimplexCounters result;
+    result.iterations = a.iterations + b.iterations;
+    result.pivots = a.pivots + b.pivots;
+    result.degenerate_pivots = a.degenerate_pivots + b.degenerate_pivots;
+    result.bound_flips = a.bound_flips + b.bound_flips;
+    result.factorizations = a.factorizations + b.factorizations;
+    result.ftran = a.ftran + b.ftran;
+    result.btran = a.btran + b.btran;
+    result.ftran_density = a.ftran_density + b.ftran_density;
+    result.btran_density = a.btran_density + b.btran_density;
+    result.pricing_time = a.pricing_time + b.pricing_time;
+    result.ratio_time = a.ratio_time + b.ratio_time;
+    result.solve_time = a.solve_time + b.solve_time;
+    result.update_time = a.update_time + b.update_time;
+    result.factorization_time = a.factorization_time + b.factorization_time;
+    return result;
+}
+
+SimplexCounters operator-(const SimplexCounters& a, const SimplexCounters& b)
+{
+    SimplexCounters result;
+    result.iterations = a.iterations - b.iterations;
+    result.pivots = a.pivots - b.pivots;
+    result.degenerate_pivots = a.degenerate_pivots - b.degenerate_pivots;
+    result.bound_flips = a.bound_flips - b.bound_flips;
+    result.factorizations = a.factorizations - b.factorizations;
+    result.ftran = a.ftran - b.ftran;
+    result.btran = a.btran - b.btran;
+    result.ftran_density = a.ftran_density - b.ftran_density;
+    result.btran_density = a.btran_density - b.btran_density;
+    result.pricing_time = a.pricing_time - b.pricing_time;
+    result.ratio_time = a.ratio_time - b.ratio_time;
+    result.solve_time = a.solve_time - b.solve_time;
+    result.update_time = a.update_time - b.update_time;
+    result.factorization_time = a.factorization_time - b.factorization_time;
+    return result;
+}
+
+static std::atomic<bool> stats_on(false);
+
+void set_stats(bool enabled)
+{
+    stats_on = enabled;
+}
+
+bool stats_enabled()
+{
+    return stats_on.load(std::memory_order_relaxed);
+}
+
+static std::atomic<bool> perturbation_on(true);
+static std::atomic<unsigned> perturbation_generator_seed(1);
+
+void set_perturbation(bool enabled, unsigned seed)
+{
+    perturbation_on = enabled;
+    perturbation_generator_seed = seed;
+}
+
+bool perturbation_enabled()
+{
+    return perturbation_on.load();
+}
+
+unsigned perturbation_seed()
+{
+    return perturbation_generator_seed.load();
+}
+
+// non-zeros/size of vector (row or column)
+static double density(const Matrix& v)
+{
+    unsigned size = v.width()*v.height(), nonzeros = 0;
+    for(unsigned i=0; i<v.height(); i++)
+        for(unsigned j=0; j<v.width(); j++)
+            if(std::fabs(v.at(i, j)) > EPS)
+                nonzeros++;
+    return size ? (double)nonzeros/size : 0.0;
+}
+
+void count_ftran(const Matrix& y)
+{
+    counters().ftran++;
+    if(stats_enabled())
+        counters().ftran_density += density(y);
+}
+
+void count_btran(const Matrix& u)
+{
+    counters().btran++;
+    if(stats_enabled())
+        counters().btran_density += density(u);
+}
+
+void print_stats(std::ostream& stream, const SimplexCounters& stats, double seconds)
+{
+    auto average = [](double sum, unsigned long count) { return count ? sum/count : 0.0; };
+    double parts[] = {stats.pricing_time, stats.ratio_time, stats.solve_time, stats.update_time, stats.factorization_time};
+    const char* names[] = {"pricing", "ratio test", "FTRAN/BTRAN", "update", "factorization"};
+    double other = seconds;
+    for(double part: parts)
+        other -= part;
+
+    stream << "Statistics:" << std::endl;
+    stream << "iterations: " << stats.iterations << ", pivots: " << stats.pivots << " (degenerate: "
+           << stats.degenerate_pivots << "), bound flips: " << stats.bound_flips
+           << ", factorizations: " << stats.factorizations << std::endl;
+    stream << "FTRAN: " << stats.ftran << " (average density " << average(stats.ftran_density, stats.ftran)
+           << "), BTRAN: " << stats.btran << " (average density " << average(stats.btran_density, stats.btran) << ")" << std::endl;
+    stream << std::endl;
+    stream << "part          | time (ms) | share (%)" << std::endl;
+    stream << "--------------|-----------|----------" << std::endl;
+    for(unsigned k=0; k<5; k++)
+        stream << std::left << std::setw(14) << names[k] << "| " << std::setw(10) << parts[k]*1000
+               << "| " << (seconds > 0 ? 100*parts[k]/seconds : 0.0) << std::endl;
+    stream << std::left << std::setw(14) << "other" << "| " << std::setw(10) << std::max(0.0, other)*1000
+           << "| " << (seconds > 0 ? 100*std::max(0.0, other)/seconds : 0.0) << std::endl;
+    stream << std::left << std::setw(14) << "total" << "| " << std::setw(10) << seconds*1000 << "| 100" << std::endl;
+    stream << std::right;
+}
+
+void write_stats_json(std::ostream& stream, const SimplexCounters& stats, double seconds)
+{
+    auto average = [](double sum, unsigned long count) { return count ? sum/count : 0.0; };
+    std::ostringstream json;
+    json << std::setprecision(9);
+    json << "{" << std::endl;
+    json << "  \"iterations\": " << stats.iterations << "," << std::endl;
+    json << "  \"pivots\": " << stats.pivots << "," << std::endl;
+    json << "  \"degenerate_pivots\": " << stats.degenerate_pivots << "," << std::endl;
+    json << "  \"bound_flips\": " << stats.bound_flips << "," << std::endl;
+    json << "  \"factorizations\": " << stats.factorizations << "," << std::endl;
+    json << "  \"ftran\": {\"count\": " << stats.ftran << ", \"average_density\": " << average(stats.ftran_density, stats.ftran) << "}," << std::endl;
+    json << "  \"btran\": {\"count\": " << stats.btran << ", \"average_density\": " << average(stats.btran_density, stats.btran) << "}," << std::endl;
+    json << "  \"seconds\": {\"pricing\": " << stats.pricing_time << ", \"ratio_test\": " << stats.ratio_time
+           << ", \"solve\": " << stats.solve_time << ", \"update\": " << stats.update_time
+           << ", \"factorization\": " << stats.factorization_time << ", \"total\": " << seconds << "}" << std::endl;
+    json << "}" << std::endl;
+    stream << json.str();
+}
+
+bool is_cancelled(const std::atomic<bool>* cancel)
+{
+    if(cancel == nullptr || !cancel->load())
+        return false;
+    out() << "Cancelled!" << std::endl;
+    return true;
+}
+
+// *LOGICAL VARIABLES*
+// System Ax + s = b has N structural columns (A) and M logical columns (s), one for every row.
+// Logical column N+i is unit vector e(i) and its cost is 0, so it is never stored:
+// every function that needs a column, cost or product with column handles logicals separately.
+// Bounds of logicals: 0 <= s(i) <= inf for inequalities, 0 <= s(i) <= 0 for equations.
+
+bool is_logical(const Matrix& A, unsigned j)
+{
+    return j >= A.width();
+}
+
+// K(j) ~ column j of system [A | E]
+Matrix get_column(const Matrix& A, unsigned j)
+{
+    if(!is_logical(A, j))
+        return A.col(j);
+    Matrix K(A.height(), 1);
+    K.at(j - A.width(), 0) = 1.0;
+    return K;
+}
+
+double get_cost(const Matrix& c, unsigned j)
+{
+    return (j < c.width()) ? c.at(0, j) : 0.0;
+}
+
+// u*K(j) (u is row vector), for logical column it is just u(i)
+double dot_column(const Matrix& A, const Matrix& u, unsigned j)
+{
+    if(is_logical(A, j))
+        return u.at(0, j - A.width());
+    double value = 0.0;
+    for(unsigned i=0; i<A.height(); i++)
+        value += u.at(0, i)*A.at(i, j);
+    return value;
+}
+
+// Violation of bounds 0 <= value <= upper
+double bound_violation(double value, double upper)
+{
+    if(value < 0.0)
+        return -value;
+    if(value > upper)
+        return value - upper;
+    return 0.0;
+}
+
+// Row with largest bound violation of base variable (STOP if there are no violations)
+unsigned get_max_violation(const Matrix& x, const std::vector<unsigned>& P, const Matrix& upper)
+{
+    unsigned row = STOP;
+    double max_violation = EPS;
+    for(unsigned i=0; i<P.size(); i++)
+    {
+        double violation = bound_violation(x.at(0, P.at(i)), upper.at(0, P.at(i)));
+        if(violation > max_violation)
+        {
+            max_violation = violation;
+            row = i;
+        }
+    }
+    return row;
+}
+
+// Crash procedure: finds starting base (P) deterministically, A is not changed:
+// Step1 (slack first): base starts with all logical columns (B = E)
+// Step2 (triangular crash): rows where logical variable is out of its bounds (b(i) < 0 or equation)
+//       are processed in order of fewest non-zero values. For each row we pick structural column
+//       that has zeros in all rows already taken by crash (B stays triangular => nonsingular),
+//       prefering column that keeps its value in bounds and then largest absolute value (stable pivot).
+// Step3 (repair): while some base variable is out of its bounds, row with largest violation is
+//       pivoted on column that leaves smallest total violation (ties: lowest index).
+//       Leaving variable is set to bound it violated (nonbase variable can be at upper bound).
+//       B ~ eta file (factorized again after ETA_REFACTOR pivots), x is updated by pivot column.
+//       Total violation is convex in delta, so its linear estimate (g*B' with g(i) = +1 above upper
+//       bound and -1 below 0) is lower bound: candidates are tested exactly (FTRAN) in order of
+//       estimate while estimate can still beat best column.
+// Returns empty P if repair doesn't reach feasible base (caller continues with phase one).
+std::pair<std::vector<unsigned>, std::vector<unsigned> >
+crash_basis(const Matrix& A, const Matrix& b, const Matrix& upper, std::vector<bool>& at_upper)
+{
+    auto m = A.height();
+    auto n = A.width();
+    std::vector<unsigned> P(m);
+    std::vector<bool> is_base(n+m, false), crashed_row(m, false);
+    at_upper.assign(n+m, false);
+
+    // Step1:
+    for(unsigned i=0; i<m; i++)
+    {
+        P.at(i) = n+i;
+        is_base.at(n+i) = true;
+    }
+
+    // Step2:
+    std::vector<std::pair<unsigned, unsigned> > rows;
+    for(unsigned i=0; i<m; i++)
+    {
+        if(bound_violation(b.at(0, i), upper.at(0, n+i)) <= EPS && upper.at(0, n+i) > 0.0)
+            continue;
+        unsigned nonzeros = 0;
+        for(unsigned j=0; j<n; j++)
+            if(std::fabs(A.at(i, j)) > EPS)
+                nonzeros++;
+        rows.push_back(std::make_pair(nonzeros, i));
+    }
+    std::sort(rows.begin(), rows.end());
+
+    for(auto[nonzeros, row]: rows)
+    {
+        unsigned col = STOP;
+        bool col_feasible = false;
+        double col_value = 0.0;
+        for(unsigned j=0; j<n; j++)
+        {
+            double value = std::fabs(A.at(row, j));
+            if(is_base.at(j) || value <= EPS)
+                continue;
+            bool triangular = true;
+            for(unsigned i=0; i<m && triangular; i++)
+                if(crashed_row.at(i) && std::fabs(A.at(i, j)) > EPS)
+                    triangular = false;
+            if(!triangular)
+                continue;
+            bool feasible = bound_violation(b.at(0, row)/A.at(row, j), upper.at(0, j)) <= EPS;
+            if((feasible && !col_feasible) || (feasible == col_feasible && value > col_value))
+            {
+                col = j;
+                col_feasible = feasible;
+                col_value = value;
+            }
+        }
+        if(col == STOP)
+            continue;
+        is_base.at(P.at(row)) = false;
+        P.at(row) = col;
+        is_base.at(col) = true;
+        crashed_row.at(row) = true;
+    }
+
+    // Step3:
+    std::vector<unsigned> Q = get_Q(P, n+m);
+    const unsigned max_repairs = 50*m;
+    std::optional<EtaFile> B;
+    Matrix x;
+    for(unsigned repair=0; repair<=max_repairs; repair++)
+    {
+        if(!B || B->etas() >= ETA_REFACTOR)
+        {
+            {
+                ScopedTimer timer(counters().factorization_time);
+                B.emplace(get_B(A, P));
+                counters().factorizations++;
+            }
+            x = Matrix(1, n+m);
+            auto xb = B->solve(get_rhs(A, b, Q, upper, at_upper, x));
+            count_ftran(xb);
+            for(unsigned i=0; i<m; i++)
+                x.at(0, P.at(i)) = xb.at(i, 0);
+        }
+        unsigned row = get_max_violation(x, P, upper);
+        if(row == STOP)
+            break;
+        if(repair == max_repairs)
+        {
+            out() << "Failed to repair starting base in " << max_repairs << " pivots!" << std::endl;
+            return std::make_pair(std::vector<unsigned>(), std::vector<unsigned>());
+        }
+
+        // Base variable in row goes to bound it violated (0 or u)
+        // x(j) changes by delta: xb(row) - alpha(j)*delta = bound, where alpha(j) = (e(row)*B')*K(j)
+        unsigned leaving = P.at(row);
+        bool to_upper = x.at(0, leaving) > 0.0;
+        double bound = to_upper ? upper.at(0, leaving) : 0.0;
+        Matrix e(1, m), g(1, m);
+        e.at(0, row) = 1.0;
+        double violation = 0.0;
+        for(unsigned i=0; i<m; i++)
+        {
+            double value = x.at(0, P.at(i));
+            if(i == row)
+                continue;
+            violation += bound_violation(value, upper.at(0, P.at(i)));
+            if(value < 0.0)
+                g.at(0, i) = -1.0;
+            else if(value > upper.at(0, P.at(i)))
+                g.at(0, i) = 1.0;
+        }
+        auto rho = B->solve_transposed(e);
+        count_btran(rho);
+        auto v = B->solve_transposed(g);
+        count_btran(v);
+
+        // estimate(j) = violation of x(j) + delta + violation of other base variables - delta*(v*K(j))
+        std::vector<std::tuple<double, unsigned, double> > candidates;
+        for(auto j: Q)
+        {
+            double alpha = dot_column(A, rho, j);
+            if(std::fabs(alpha) <= EPS)
+                continue;
+            double delta = (x.at(0, leaving) - bound)/alpha;
+            // variable at lower bound can only increase and variable at upper bound can only decrease
+            if((delta < 0) != at_upper.at(j))
+                continue;
+            double estimate = bound_violation(x.at(0, j) + delta, upper.at(0, j)) + violation - delta*dot_column(A, v, j);
+            candidates.push_back(std::make_tuple(estimate, j, delta));
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        // total violation after change (entering variable and all base variables except leaving one)
+        unsigned col = STOP;
+        double best = INF, col_delta = 0.0;
+        Matrix col_y;
+        for(const auto& [estimate, j, delta]: candidates)
+        {
+            if(estimate > best + EPS)
+                break;
+            auto y = B->solve(get_column(A, j));
+            count_ftran(y);
+            double infeasibility = bound_violation(x.at(0, j) + delta, upper.at(0, j));
+            for(unsigned i=0; i<m; i++)
+                if(i != row)
+                    infeasibility += bound_violation(x.at(0, P.at(i)) - y.at(i, 0)*delta, upper.at(0, P.at(i)));
+            if(infeasibility < best - EPS || (infeasibility <= best + EPS && j < col))
+            {
+                best = std::min(best, infeasibility);
+                col = j;
+                col_delta = delta;
+                col_y = y;
+            }
+        }
+        if(col == STOP)
+        {
+            out() << "Row " << row << " of starting base can't be repaired!" << std::endl;
+            return std::make_pair(std::vector<unsigned>(), std::vector<unsigned>());
+        }
+        for(unsigned i=0; i<m; i++)
+            x.at(0, P.at(i)) -= col_y.at(i, 0)*col_delta;
+        x.at(0, col) += col_delta;
+        x.at(0, leaving) = bound;
+        B->update(row, col_y);
+        update_P_Q(P, Q, leaving, col);
+        counters().pivots++;
+        at_upper.at(leaving) = to_upper;
+        at_upper.at(col) = false;
+    }
+
+    return std::make_pair(P, Q);
+}
+
+// B ~ base matrix, logical columns are unit vectors
+Matrix get_B(const Matrix& A, const std::vector<unsigned>& P)
+{
+    Matrix B(A.height(), P.size());
+    for(unsigned k=0; k<P.size(); k++)
+    {
+        unsigned p = P.at(k);
+        if(is_logical(A, p))
+            B.at(p - A.width(), k) = 1.0;
+        else
+            for(unsigned i=0; i<A.height(); i++)
+                B.at(i, k) = A.at(i, p);
+    }
+
+    return B;
+}
+
+Matrix get_Cb(const Matrix& c, const std::vector<unsigned>& P)
+{
+    Matrix Cb = Matrix(1, P.size());
+    for(unsigned i=0; i<P.size(); i++)
+        Cb.at(0, i) = get_cost(c, P.at(i));
+
+    return Cb;
+}
+
+// r(j) = c(j) - u*K(j) for j in Q (logical column: r(j) = -u(i))
+Matrix get_r(const Matrix& A, const Matrix& c, const Matrix& u, const std::vector<unsigned>& Q)
+{
+    Matrix r(1, Q.size());
+    for(unsigned k=0; k<Q.size(); k++)
+        r.at(0, k) = get_cost(c, Q.at(k)) - dot_column(A, u, Q.at(k));
+
+    return r;
+}
+
+// Bland's rule: first r(i) that improves function
+// r(i) < 0 for variable at lower bound (it increases) or r(i) > 0 for variable at upper bound (it decreases)
+unsigned get_first_improving(const Matrix& r, const std::vector<unsigned>& Q, const Matrix& upper,
+                             const std::vector<bool>& at_upper)
+{
+    for(unsigned i=0; i<r.width(); i++)
+    {
+        // fixed variable (0 <= x <= 0, ex. logical variable of equation) can't move, its step is always 0
+        if(upper.at(0, Q.at(i)) == 0.0)
+            continue;
+        if((!at_upper.at(Q.at(i)) && r.at(0, i) < -EPS) || (at_upper.at(Q.at(i)) && r.at(0, i) > EPS))
+            return i;
+    }
+    return STOP;
+}
+
+// Nonbase variables: x(i) = u(i) if i in Q is at upper bound, x(i) = 0 for other i in Q
+// Returns rhs = b - Kq*xq (Mx1) of system B*xb = rhs
+Matrix get_rhs(const Matrix& A, const Matrix& b, const std::vector<unsigned>& Q,
+               const Matrix& upper, const std::vector<bool>& at_upper, Matrix& x)
+{
+    auto rhs = b.transpose();
+    for(auto q: Q)
+        if(at_upper.at(q) && upper.at(0, q) != 0.0)
+        {
+            x.at(0, q) = upper.at(0, q);
+            if(is_logical(A, q))
+                rhs.at(q - A.width(), 0) -= upper.at(0, q);
+            else
+                for(unsigned i=0; i<A.height(); i++)
+                    rhs.at(i, 0) -= A.at(i, q)*upper.at(0, q);
+        }
+    return rhs;
+}
+
+// Starting with x: nonbase variables are at their bounds (get_rhs)
+// and base values are solution of B*xb = b - Kq*xq
+Matrix get_x(const Matrix& A, const Matrix& b, const std::vector<unsigned>& P, const std::vector<unsigned>& Q,
+             const Matrix& upper, const std::vector<bool>& at_upper)
+{
+    Matrix x(1, A.width() + A.height(), 0);
+    auto rhs = get_rhs(A, b, Q, upper, at_upper, x);
+
+    std::optional<LU> lu;
+    {
+        ScopedTimer timer(counters().factorization_time);
+        lu.emplace(get_B(A, P));
+        counters().factorizations++;
+    }
+    Matrix xb;
+    {
+        ScopedTimer timer(counters().solve_time);
+        xb = lu->solve(rhs);
+        count_ftran(xb);
+    }
+    for(unsigned i=0; i<P.size(); i++)
+        x.at(0, P.at(i)) = xb.at(i, 0);
+
+    return x;
+}
+
+// Ratio test: x(l) changes by direction*t (direction = 1 if x(l) increases, -1 if it decreases)
+// base variable x(i) changes by -direction*t*y(i) and must stay in [0, u(i)]
+// Returns (t_opt, leaving column, true if leaving variable goes to upper bound)
+// If x(l) reaches its own bound first then leaving column is l (bound flip)
+std::tuple<double, unsigned, bool> get_t_opt(const Matrix& x, const Matrix& y, const std::vector<unsigned>& P,
+                                             const Matrix& upper, unsigned l, double direction)
+{
+    double t = upper.at(0, l);
+    unsigned t_index = (t < INF) ? l : STOP;
+    bool to_upper = direction > 0;
+    for(unsigned i=0; i<y.width(); i++)
+    {
+        unsigned p = P.at(i);
+        double rate = direction*y.at(0, i);
+        double val = INF;
+        bool up = false;
+        if(rate > EPS)
+            val = x.at(0, p)/rate;
+        else if(rate < -EPS && upper.at(0, p) < INF)
+        {
+            val = (upper.at(0, p) - x.at(0, p))/(-rate);
+            up = true;
+        }
+        if(val < t)
+        {
+            t = val;
+            t_index = p;
+            to_upper = up;
+        }
+    }
+
+    return std::make_tuple(t, t_index, to_upper);
+}
+
+// x(i) = x_old(i) - t*y(i), for i in P and x(l) = x_old(l) + t
+void update_x(Matrix& x, const Matrix& y, unsigned l, const std::vector<unsigned>& P, double t)
+{
+    for(unsigned i=0; i<y.width(); i++)
+    {
+        unsigned index = P.at(i);
+        x.at(0, index) -= y.at(0, i)*t;
+    }
+    x.at(0, l) += t;
+}
+
+void update_P_Q(std::vector<unsigned>& P, std::vector<unsigned>& Q, unsigned t_index, unsigned l)
+{
+    for(auto& p: P)
+        if(p == t_index)
+        {
+            p = l;
+            break;
+        }
+    for(auto& q: Q)
+        if(q == l)
+        {
+            q = t_index;
+            break;
+        }
+}
+
+// Perturbation of b: b' = b + B*e, so only base variables change (xb' = xb + e)
+// e(i) > 0 for base variable closer to its lower bound and e(i) < 0 for variable closer to
+// its upper bound, fixed variables (u < 4*|e(i)|) are not moved
+// Returns number of moved variables
+unsigned perturb(Matrix& x, const std::vector<unsigned>& P, const Matrix& upper, std::mt19937& generator)
+{
+    std::uniform_real_distribution<double> factor(1.0, 2.0);
+    unsigned moved = 0;
+    for(auto p: P)
+    {
+        double value = x.at(0, p), bound = upper.at(0, p);
+        double delta = PERTURBATION*factor(generator)*std::max(1.0, std::fabs(value));
+        if(bound < 4*delta)
+            continue;
+        x.at(0, p) += (value <= bound - value) ? delta : -delta;
+        moved++;
+    }
+    return moved;
+}
+
+std::pair<double, Matrix> residual_simplex(const Matrix& A, const Matrix& b, const Matrix& c,
+                                           std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                                           const Matrix& upper, std::vector<bool>& at_upper,
+                                           const std::atomic<bool>* cancel)
+{
+
+    // Preprocess: Calculating x:
+    // B ~ eta file: B = B0*E1*...*Ek, B0 is factorized (LU) at start and after every
+    // ETA_REFACTOR changes of base, otherwise change of base only adds eta matrix
+    auto x = get_x(A, b, P, Q, upper, at_upper);
+    out() << "Starting x value: " << x << std::endl;
+    std::optional<EtaFile> B;
+    unsigned iteration = 0, pivots = 0, degenerate = 0;
+    bool perturbed = false;
+    std::mt19937 generator(perturbation_seed());
+    while(true)
+    {
+        if(is_cancelled(cancel))
+            return std::make_pair(0, Matrix());
+        out() << BAR << std::endl;
+        out() << "ITERATION " << iteration++ << ":" << std::endl;
+        counters().iterations++;
+        // Cb ~ contains values from c where c(i) is in Cb if i is in P
+        // P = [1, 3, 4], C = [c1, c2, ... cN] => Cb = [c1, c3, c4]
+
+        // Step1: Solve u*B = Cb <=> u = Cb*B' (B' is inverse matrix of B)
+        // This is equivalent to u*K(i) = c(i) for i in P which is what we need to find optimal value
+        // Same eta file is used for both systems (1) and (2)
+        if(!B || B->etas() >= ETA_REFACTOR)
+        {
+            ScopedTimer timer(counters().factorization_time);
+            B.emplace(get_B(A, P));
+            counters().factorizations++;
+            out() << "B is factorized: B = B0" << std::endl;
+        }
+        else
+        {
+            out() << "B = B0";
+            for(unsigned k=1; k<=B->etas(); k++)
+                out() << "*E" << k;
+            out() << std::endl;
+        }
+
+        auto Cb = get_Cb(c, P);
+        Matrix u;
+        {
+            ScopedTimer timer(counters().solve_time);
+            u = B->solve_transposed(Cb);
+            count_btran(u);
+        }
+        out() << "Step1: Solving system(1): uB = Cb" << std::endl;
+        out() << "Cb: " << Cb << std::endl;
+        out() << "Result of u(1):" << u << std::endl;
+
+        // Step2: Calculating r
+        // r(j) = c(j) - u*K(j) (r(j) = -u(i) for logical column j = N+i)
+        // if (r >= 0 for variables at lower bound and r <= 0 for variables at upper bound)
+        // then we found our optimal value
+        // This is equivalent to (l_index == STOP) which we get from get_first_improving(r)
+        std::optional<ScopedTimer> timer(counters().pricing_time);
+        auto r = get_r(A, c, u, Q);
+        auto l_index = get_first_improving(r, Q, upper, at_upper);
+        timer.reset();
+        out() << "Step2: Calculating r (r := C - uK):" << std::endl;
+        out() << "Nonbase indexes(Q): ";
+        vector_print(Q);
+        out() << "Result(r): " << r << std::endl;
+
+        if(l_index == STOP)
+        {
+            out() << "(r > 0) is true => optimal value is found!" << std::endl;
+            break;
+        }
+        auto l = Q.at(l_index);
+        double direction = at_upper.at(l) ? -1.0 : 1.0;
+        out() << "Bland's rule: first improving r(i) is r" << l_index << "!" << std::endl;
+
+        // Step3: Solve B*y = Kl <=> y = B'Kl <=> y = B/Kl
+        auto Kl = get_column(A, l);
+        timer.emplace(counters().solve_time);
+        auto y = B->solve(Kl).transpose();
+        count_ftran(y);
+        timer.reset();
+        out() << "Step3: Solving system(2): By = K" << l_index << std::endl;
+        out() << "K" << l << ": " << std::endl << Kl << std::endl;
+        out() << "Result of y(2):" << y << std::endl;
+
+        // Step4: t_opt := max t such that all base variables and x(l) stay in their bounds
+        // If there is no such t then there is no optimum value (its not bounded)
+        out() << "Step4: Finding optimal t:" << std::endl;
+        timer.emplace(counters().ratio_time);
+        auto[t_opt, t_index, to_upper] = get_t_opt(x, y, P, upper, l, direction);
+        timer.reset();
+        if(t_index == STOP)
+        {
+            out() << "Function does not reach optimal value because t is not bounded!" << std::endl;
+            return std::make_pair(0, Matrix());
+        }
+        out() << "Optimal t: " << t_opt << std::endl;
+
+        // Step5: With t_opt we can update our x:
+        // x(i) = x_old(i) - direction*t_opt*y(i), for i in P
+        // x(i) = x_old(i) + direction*t_opt, for i == l
+        // If x(l) reached its other bound (bound flip) base stays the same,
+        // otherwise we replace t_index in P with l and l in Q with t_index (new base P)
+        out() << "Step5: updating x:" << std::endl;
+        out() << "Old x: " << x;
+        timer.emplace(counters().update_time);
+        update_x(x, y, l, P, direction*t_opt);
+        if(t_index == l)
+        {
+            out() << "Column " << l << " moves to its other bound (bound flip)" << std::endl;
+            at_upper.at(l) = !at_upper.at(l);
+            counters().bound_flips++;
+        }
+        else
+        {
+            out() << "Column " << t_index << " leaves base (P)" << std::endl;
+            unsigned row = std::find(P.begin(), P.end(), t_index) - P.begin();
+            B->update(row, y.transpose());
+            update_P_Q(P, Q, t_index, l);
+            counters().pivots++;
+            pivots++;
+            if(t_opt <= EPS)
+            {
+                counters().degenerate_pivots++;
+                degenerate++;
+            }
+            at_upper.at(l) = false;
+            at_upper.at(t_index) = to_upper;
+            x.at(0, t_index) = to_upper ? upper.at(0, t_index) : 0.0;
+        }
+        timer.reset();
+        out() << "New x: " << x << std::endl;
+
+        // Anti-degeneracy: if most of pivots had step 0 (stalling), b is perturbed once so
+        // ratio test has no ties at 0 (perturbation is removed when optimum is found)
+        if(!perturbed && perturbation_enabled() && pivots >= PERTURB_MIN_PIVOTS && degenerate >= PERTURB_RATIO*pivots)
+        {
+            unsigned moved = perturb(x, P, upper, generator);
+            perturbed = true;
+            out() << "Degenerate pivots: " << degenerate << " of " << pivots << " => b is perturbed (seed "
+                  << perturbation_seed() << ", " << moved << " base variables moved)" << std::endl;
+            out() << "Perturbed x: " << x << std::endl;
+        }
+    }
+    out() << BAR << std::endl;
+    out() << "Number of iterations: " << iteration << std::endl;
+
+    // Cleanup: x is calculated again for original b, optimal base stays dual feasible (c is same)
+    // and if it is not primal feasible anymore then dual simplex continues from it
+    if(perturbed)
+    {
+        x = get_x(A, b, P, Q, upper, at_upper);
+        out() << "Perturbation is removed, x: " << x << std::endl;
+        if(get_max_violation(x, P, upper) != STOP)
+        {
+            out() << "Base is not feasible for original b => dual simplex (cleanup):" << std::endl;
+            return dual_simplex(A, b, c, P, Q, upper, at_upper, cancel);
+        }
+    }
+
+    // c*x (logical variables have cost 0)
+    double F = 0.0;
+    for(unsigned j=0; j<c.width(); j++)
+        F += c.at(0, j)*x.at(0, j);
+    return std::make_pair(F, x);
+}
+
+// Column of nonbase variable j (y = B'K(j)) for lexicographic rules: change of every variable of
+// system per unit move t of x(j) from its bound (x(j) increases at lower, decreases at upper bound),
+// base variable in row i changes by -direction*y(i)
+static std::vector<double> lexicographic_column(const Matrix& y, const std::vector<unsigned>& P,
+                                                unsigned j, bool at_upper, unsigned width)
+{
+    double direction = at_upper ? -1.0 : 1.0;
+    std::vector<double> column(width, 0.0);
+    for(unsigned i=0; i<P.size(); i++)
+        column.at(P.at(i)) = -direction*y.at(i, 0);
+    column.at(j) = direction;
+    return column;
+}
+
+// first component that differs by more than LEX_TOLERANCE decides
+static bool lexicographically_less(const std::vector<double>& first, const std::vector<double>& second)
+{
+    for(unsigned k=0; k<first.size(); k++)
+        if(std::fabs(first.at(k) - second.at(k)) > LEX_TOLERANCE)
+            return first.at(k) < second.at(k);
+    return false;
+}
+
+// Revised dual simplex: starts from base P which is dual feasible (r >= 0 for variables at
+// lower bound, r <= 0 for variables at upper bound) but not primal feasible (some x(i), i in P,
+// is out of its bounds). Every iteration moves one base variable out of base to the bound it
+// violated while keeping dual feasibility. Only row of B'A that belongs to leaving variable
+// (pivot row) and column of entering variable (pivot column) are calculated:
+// B ~ eta file (factorized at start and after ETA_REFACTOR changes of base), x and r are updated
+// Dual steepest edge: leaving row has largest violation(i)^2/w(i), w(i) ~ ||e(i)*B'||^2
+// (weights start at 1 and are updated with tau = B'rho on every change of base)
+// Bound flipping ratio test: boxed variables whose ratio |r/alpha| is passed move to their other
+// bound while violation of leaving variable is still not removed, so one iteration can do many flips
+std::pair<double, Matrix> dual_simplex(const Matrix& A, const Matrix& b, const Matrix& c,
+                                       std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                                       const Matrix& upper, std::vector<bool>& at_upper,
+                                       const std::atomic<bool>* cancel, bool lexicographic,
+                                       std::optional<EtaFile>* basis)
+{
+    auto n = A.width();
+    auto m = A.height();
+    std::optional<EtaFile> B;
+    if(basis != nullptr && *basis && (*basis)->size() == m)
+        B = std::move(*basis);
+    Matrix x, r(1, n+m);
+    std::vector<double> w(m, 1.0);
+    unsigned iteration = 0;
+    while(true)
+    {
+        if(is_cancelled(cancel))
+            return std::make_pair(0, Matrix());
+        out() << BAR << std::endl;
+        out() << "ITERATION " << iteration++ << ":" << std::endl;
+        counters().iterations++;
+
+        // Step1: B is factorized, x (B*xb = b - Kq*xq) and r (u*B = Cb, r = c - uK) are calculated
+        // again at start and after ETA_REFACTOR changes of base (or bordered rows), otherwise they are updated
+        bool refactor = !B || B->etas() + B->borders() >= ETA_REFACTOR;
+        if(refactor || x.width() == 0)
+        {
+            if(refactor)
+            {
+                ScopedTimer timer(counters().factorization_time);
+                B.emplace(get_B(A, P));
+                counters().factorizations++;
+            }
+            ScopedTimer timer(counters().solve_time);
+            x = Matrix(1, n+m);
+            auto rhs = get_rhs(A, b, Q, upper, at_upper, x);
+            auto xb = B->solve(rhs);
+            count_ftran(xb);
+            for(unsigned i=0; i<m; i++)
+                x.at(0, P.at(i)) = xb.at(i, 0);
+            auto u = B->solve_transposed(get_Cb(c, P));
+            count_btran(u);
+            r = Matrix(1, n+m);
+            for(auto q: Q)
+                r.at(0, q) = get_cost(c, q) - dot_column(A, u, q);
+            if(refactor)
+                out() << "Step1: B is factorized: B = B0" << std::endl;
+            else
+                out() << "Step1: B is given: " << B->etas() << " eta matrices, " << B->borders() << " bordered rows" << std::endl;
+        }
+        else
+        {
+            out() << "Step1: B = B0";
+            for(unsigned k=1; k<=B->etas(); k++)
+                out() << "*E" << k;
+            out() << std::endl;
+        }
+        out() << "Result(x): " << x << std::endl;
+
+        // Step2 (dual steepest edge): leaving variable is base variable with largest violation^2/w
+        // If there are no violations then optimal value is found
+        std::optional<ScopedTimer> timer(counters().pricing_time);
+        unsigned row = STOP;
+        double best = 0.0;
+        for(unsigned i=0; i<m; i++)
+        {
+            double violation = bound_violation(x.at(0, P.at(i)), upper.at(0, P.at(i)));
+            if(violation > EPS && violation*violation/w.at(i) > best)
+            {
+                best = violation*violation/w.at(i);
+                row = i;
+            }
+        }
+        timer.reset();
+        if(row == STOP)
+        {
+            out() << "(0 <= xb <= u) is true => optimal value is found!" << std::endl;
+            out() << BAR << std::endl;
+            out() << "Number of iterations: " << iteration << std::endl;
+            double F = 0.0;
+            for(unsigned j=0; j<c.width(); j++)
+                F += c.at(0, j)*x.at(0, j);
+            if(basis != nullptr)
+                *basis = std::move(B);
+            return std::make_pair(F, x);
+        }
+        unsigned leaving = P.at(row);
+        bool to_upper = x.at(0, leaving) > 0.0;
+        double bound = to_upper ? upper.at(0, leaving) : 0.0;
+        out() << "Step2: Column " << leaving << " leaves base (P) to its "
+                  << (to_upper ? "upper" : "lower") << " bound, violation^2/w: " << best << std::endl;
+
+        // Step3: Pivot row: alpha(j) = (e(row)*B')*K(j)
+        // x(P(row)) changes by -alpha(j)*dx(j), entering variable must move it towards its bound:
+        // variable at lower bound increases (dx > 0), variable at upper bound decreases (dx < 0)
+        // Fixed variables (u = 0) never enter base
+        Matrix e(1, m);
+        e.at(0, row) = 1.0;
+        timer.emplace(counters().solve_time);
+        auto rho = B->solve_transposed(e);
+        count_btran(rho);
+        timer.emplace(counters().ratio_time);
+        Matrix alpha(1, n+m);
+        std::vector<std::pair<double, unsigned> > candidates;
+        for(auto q: Q)
+        {
+            alpha.at(0, q) = dot_column(A, rho, q);
+            if(std::fabs(alpha.at(0, q)) <= EPS || upper.at(0, q) == 0.0)
+                continue;
+            // sign of alpha that moves x(P(row)) in right direction
+            bool increases = !at_upper.at(q);
+            if((alpha.at(0, q) > 0) != (increases == to_upper))
+                continue;
+            candidates.push_back(std::make_pair(std::fabs(r.at(0, q)/alpha.at(0, q)), q));
+        }
+        if(candidates.empty())
+        {
+            out() << "System has no solution because base variable in row " << row << " can't reach its bound!" << std::endl;
+            return std::make_pair(0, Matrix());
+        }
+
+        // Step4 (bound flipping ratio test): candidates are sorted by ratio |r/alpha|, slope starts
+        // with violation of leaving variable and passing ratio of boxed variable j lowers it by
+        // |alpha(j)|*u(j) (j moves to its other bound), first variable that would make slope
+        // negative (or has no upper bound) enters base (dual feasibility is kept for all of them)
+        std::stable_sort(candidates.begin(), candidates.end());
+        double slope = std::fabs(x.at(0, leaving) - bound);
+        std::vector<unsigned> flips;
+        unsigned l = STOP;
+        double ratio = 0.0;
+        // Lexicographic ratio test: candidates with smallest ratio are compared by R(j)/|alpha(j)|
+        std::vector<double> best_column;
+        for(const auto& [candidate_ratio, q]: candidates)
+        {
+            if(!lexicographic)
+                break;
+            if(candidate_ratio > candidates.front().first + LEX_TOLERANCE*std::max(1.0, candidates.front().first))
+                break;
+            auto y = B->solve(get_column(A, q));
+            count_ftran(y);
+            auto column = lexicographic_column(y, P, q, at_upper.at(q), n+m);
+            for(auto& value: column)
+                value /= std::fabs(alpha.at(0, q));
+            if(l == STOP || lexicographically_less(column, best_column))
+            {
+                l = q;
+                ratio = candidate_ratio;
+                best_column = column;
+            }
+        }
+        for(const auto& candidate: candidates)
+        {
+            if(lexicographic)
+                break;
+            unsigned q = candidate.second;
+            double next = slope - std::fabs(alpha.at(0, q))*upper.at(0, q);
+            if(upper.at(0, q) < INF && next >= 0.0 && &candidate != &candidates.back())
+            {
+                flips.push_back(q);
+                slope = next;
+                continue;
+            }
+            l = q;
+            ratio = candidate.first;
+            break;
+        }
+        timer.reset();
+        out() << "Step3: Column " << l << " enters base (P), ratio |r/alpha|: " << ratio << std::endl;
+
+        // Step5: Flipped variables move to their other bound: xb = xb - B'(sum K(j)*dx(j))
+        if(!flips.empty())
+        {
+            timer.emplace(counters().update_time);
+            Matrix delta(m, 1);
+            for(auto j: flips)
+            {
+                double dx = at_upper.at(j) ? -upper.at(0, j) : upper.at(0, j);
+                if(is_logical(A, j))
+                    delta.at(j-n, 0) += dx;
+                else
+                    for(unsigned i=0; i<m; i++)
+                        delta.at(i, 0) += A.at(i, j)*dx;
+                x.at(0, j) += dx;
+                at_upper.at(j) = !at_upper.at(j);
+                counters().bound_flips++;
+            }
+            auto y = B->solve(delta);
+            count_ftran(y);
+            for(unsigned i=0; i<m; i++)
+                x.at(0, P.at(i)) -= y.at(i, 0);
+            timer.reset();
+            out() << "Step4: " << flips.size() << " variables moved to their other bound (bound flips): ";
+            vector_print(flips);
+        }
+
+        // Step6: Pivot column: y = B'K(l), x(l) changes by t so leaving variable reaches its bound
+        // t = (x(P(row)) - bound)/y(row), xb = xb - t*y
+        timer.emplace(counters().solve_time);
+        auto y = B->solve(get_column(A, l));
+        count_ftran(y);
+        auto tau = B->solve(rho.transpose());
+        count_ftran(tau);
+        timer.emplace(counters().update_time);
+        double pivot = y.at(row, 0);
+        double t = (x.at(0, leaving) - bound)/pivot;
+        for(unsigned i=0; i<m; i++)
+            x.at(0, P.at(i)) -= t*y.at(i, 0);
+        x.at(0, l) += t;
+        x.at(0, leaving) = bound;
+
+        // Step7: r(j) = r(j) - theta*alpha(j), theta = r(l)/alpha(l), leaving variable gets r = -theta
+        double theta = r.at(0, l)/alpha.at(0, l);
+        for(auto q: Q)
+            r.at(0, q) -= theta*alpha.at(0, q);
+        r.at(0, l) = 0.0;
+        r.at(0, leaving) = -theta;
+
+        // Step8: Weights of dual steepest edge: w(row) = ||rho||^2/pivot^2,
+        // w(i) = w(i) - 2*(y(i)/pivot)*tau(i) + (y(i)/pivot)^2*||rho||^2 for other rows
+        double w_row = 0.0;
+        for(unsigned i=0; i<m; i++)
+            w_row += rho.at(0, i)*rho.at(0, i);
+        for(unsigned i=0; i<m; i++)
+        {
+            if(i == row)
+                continue;
+            double k = y.at(i, 0)/pivot;
+            w.at(i) = std::max(w.at(i) - 2*k*tau.at(i, 0) + k*k*w_row, EPS);
+        }
+        w.at(row) = std::max(w_row/(pivot*pivot), EPS);
+
+        // Step9: change of base adds eta matrix
+        B->update(row, y);
+        update_P_Q(P, Q, leaving, l);
+        counters().pivots++;
+        if(std::fabs(theta) <= EPS)
+            counters().degenerate_pivots++;
+        at_upper.at(leaving) = to_upper;
+        at_upper.at(l) = false;
+        timer.reset();
+    }
+}
+
+unsigned lexicographic_optimum(const Matrix& A, const Matrix& b, const Matrix& c,
+                               std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                               const Matrix& upper, std::vector<bool>& at_upper, Matrix& x)
+{
+    auto n = A.width();
+    auto m = A.height();
+    unsigned pivots = 0;
+    while(true)
+    {
+        // Step1: B is factorized, x and duals u (u*B = Cb) of current base
+        LU lu(get_B(A, P));
+        counters().factorizations++;
+        x = Matrix(1, n+m);
+        auto xb = lu.solve(get_rhs(A, b, Q, upper, at_upper, x));
+        count_ftran(xb);
+        for(unsigned i=0; i<m; i++)
+            x.at(0, P.at(i)) = xb.at(i, 0);
+        auto u = lu.solve_transposed(get_Cb(c, P));
+        count_btran(u);
+
+        // Step2 (Bland's rule): smallest nonbase variable with r(j) = 0 and lexicographically
+        // negative column enters base (its move keeps c*x and makes x lexicographically smaller)
+        std::vector<unsigned> order = Q;
+        std::sort(order.begin(), order.end());
+        unsigned l = STOP;
+        Matrix y;
+        for(auto q: order)
+        {
+            if(upper.at(0, q) == 0.0 || std::fabs(get_cost(c, q) - dot_column(A, u, q)) > LEX_TOLERANCE)
+                continue;
+            y = lu.solve(get_column(A, q));
+            count_ftran(y);
+            auto column = lexicographic_column(y, P, q, at_upper.at(q), n+m);
+            if(lexicographically_less(column, std::vector<double>(n+m, 0.0)))
+            {
+                l = q;
+                break;
+            }
+        }
+        if(l == STOP)
+        {
+            out() << "Lexicographic optimum: " << pivots << " pivots" << std::endl;
+            return pivots;
+        }
+
+        // Step3: ratio test, ties go to smallest leaving column (Bland's rule), t is finite because
+        // first non-zero component of column is variable that decreases towards its bound
+        double direction = at_upper.at(l) ? -1.0 : 1.0;
+        double t = upper.at(0, l);
+        unsigned t_index = (t < INF) ? l : STOP;
+        bool to_upper = direction > 0;
+        for(unsigned i=0; i<m; i++)
+        {
+            unsigned p = P.at(i);
+            double rate = direction*y.at(i, 0), value = INF;
+            bool up = false;
+            if(rate > LEX_TOLERANCE)
+                value = std::max(0.0, x.at(0, p))/rate;
+            else if(rate < -LEX_TOLERANCE && upper.at(0, p) < INF)
+            {
+                value = std::max(0.0, upper.at(0, p) - x.at(0, p))/(-rate);
+                up = true;
+            }
+            if(value < t - LEX_TOLERANCE || (value <= t + LEX_TOLERANCE && t_index != STOP && p < t_index))
+            {
+                t = value;
+                t_index = p;
+                to_upper = up;
+            }
+        }
+        if(t_index == STOP)
+            return pivots;
+
+        // Step4: x(l) moves to its other bound (bound flip) or enters base
+        pivots++;
+        counters().pivots++;
+        if(t <= LEX_TOLERANCE)
+            counters().degenerate_pivots++;
+        if(t_index == l)
+        {
+            at_upper.at(l) = !at_upper.at(l);
+            counters().bound_flips++;
+            continue;
+        }
+        update_P_Q(P, Q, t_index, l);
+        at_upper.at(t_index) = to_upper;
+        at_upper.at(l) = false;
+    }
+}
+
+// Phase one system of two-phase and composite simplex:
+// Ax + Ww + s = b, all variables in their bounds
+// Starting point is x = 0: row i keeps logical variable in base if 0 <= b(i) <= u(N+i),
+// otherwise it gets artificial variable w with value |b(i) - bound| and column sign*e(i):
+// b(i) < 0 => s(i) = 0 and column -e(i), b(i) > u(N+i) => s(i) = u(N+i) and column e(i)
+// Columns of A1 = [A | W]: structural 0..N-1, artificial N..N+K-1, logical N+K..N+K+M-1
+// Returns rows of artificial variables (K = size)
+static std::vector<unsigned> add_artificials(const Matrix& A, const Matrix& b, const Matrix& upper,
+                                             Matrix& A1, Matrix& upper1, std::vector<unsigned>& P1,
+                                             std::vector<unsigned>& Q1, std::vector<bool>& at_upper1)
+{
+    auto n = A.width();
+    auto m = A.height();
+    std::vector<unsigned> rows;
+    std::vector<double> signs;
+    for(unsigned i=0; i<m; i++)
+        if(b.at(0, i) < -EPS || b.at(0, i) > upper.at(0, n+i) + EPS)
+        {
+            rows.push_back(i);
+            signs.push_back(b.at(0, i) < 0 ? -1.0 : 1.0);
+        }
+    unsigned k = rows.size();
+
+    Matrix W(m, k);
+    A1 = A;
+    upper1 = Matrix(1, n+k+m, INF);
+    for(unsigned a=0; a<k; a++)
+        W.at(rows.at(a), a) = signs.at(a);
+    append(A1, W);
+    for(unsigned j=0; j<n; j++)
+        upper1.at(0, j) = upper.at(0, j);
+    for(unsigned i=0; i<m; i++)
+        upper1.at(0, n+k+i) = upper.at(0, n+i);
+
+    P1.assign(m, 0);
+    at_upper1.assign(n+k+m, false);
+    for(unsigned i=0; i<m; i++)
+        P1.at(i) = n+k+i;
+    for(unsigned a=0; a<k; a++)
+    {
+        P1.at(rows.at(a)) = n+a;
+        at_upper1.at(n+k+rows.at(a)) = signs.at(a) > 0;
+    }
+    Q1 = get_Q(P1, n+k+m);
+    return rows;
+}
+
+// Phase two of two-phase and composite simplex:
+// Base of phase one is feasible for original system, so phase two continues from it in place:
+// artificial variables become inactive (u = 0, fixed variables are never priced again) and
+// objective is swapped to [c | 0], B and x are not calculated from scratch
+// Artificial variable that stays in base keeps value 0 (rows that are linearly dependent
+// keep it until the end, ratio test moves out others when their row is needed)
+static std::pair<double, Matrix> artificial_phase_two(const Matrix& A, const Matrix& b, const Matrix& c,
+                                                      const std::vector<unsigned>& rows, const Matrix& A1,
+                                                      Matrix& upper1, std::vector<unsigned>& P1,
+                                                      std::vector<unsigned>& Q1, std::vector<bool>& at_upper1,
+                                                      std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                                                      std::vector<bool>& at_upper, const std::atomic<bool>* cancel)
+{
+    auto n = A.width();
+    auto m = A.height();
+    unsigned k = rows.size();
+    Matrix c1(1, n+k);
+    for(unsigned a=0; a<k; a++)
+        upper1.at(0, n+a) = 0.0;
+    for(unsigned j=0; j<n; j++)
+        c1.at(0, j) = c.at(0, j);
+    out() << BAR << std::endl;
+    out() << "Phase two, base indexes(P): ";
+    vector_print(P1);
+    auto[F, x2] = residual_simplex(A1, b, c1, P1, Q1, upper1, at_upper1, cancel);
+
+    // Columns of A1 are mapped back to [A | E]: artificial variable n+a that is still in base is
+    // replaced with logical variable of its row (column e(i) instead of -e(i) or e(i), so B stays
+    // regular and x does not change: logical variable keeps its value at bound)
+    auto column = [n, k, &rows](unsigned j) {
+        if(j < n)
+            return j;
+        return (j < n+k) ? n + rows.at(j-n) : j-k;
+    };
+    P.resize(m);
+    at_upper.assign(n+m, false);
+    for(unsigned i=0; i<m; i++)
+        P.at(i) = column(P1.at(i));
+    for(unsigned j=0; j<n+k+m; j++)
+        if(j < n || j >= n+k)
+            at_upper.at(column(j)) = at_upper1.at(j);
+    for(auto p: P)
+        at_upper.at(p) = false;
+    Q = get_Q(P, n+m);
+    if(x2.width() == 0)
+        return std::make_pair(F, x2);
+
+    Matrix x(1, n+m);
+    for(unsigned j=0; j<n+k+m; j++)
+        if(j < n || j >= n+k)
+            x.at(0, column(j)) = x2.at(0, j);
+    return std::make_pair(F, x);
+}
+
+std::pair<double, Matrix> two_phase_simplex(const Matrix& A, const Matrix& b, const Matrix& c,
+                                            std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                                            const Matrix& upper, std::vector<bool>& at_upper,
+                                            const std::atomic<bool>* cancel)
+{
+    auto n = A.width();
+
+    // *PHASE ONE*
+    // STEP1: Creating subgoal system (add_artificials):
+    // (min) w1 + w2 + ... + wK
+    // Ax + Ww + s = b, all variables in their bounds
+    Matrix A1, upper1;
+    std::vector<unsigned> P1, Q1;
+    std::vector<bool> at_upper1;
+    auto rows = add_artificials(A, b, upper, A1, upper1, P1, Q1, at_upper1);
+    unsigned k = rows.size();
+    Matrix c1(1, n+k);
+    for(unsigned a=0; a<k; a++)
+        c1.at(0, n+a) = 1;
+
+    out() << "Phase one: " << k << " artificial variables" << std::endl;
+    auto[F1, x1] = residual_simplex(A1, b, c1, P1, Q1, upper1, at_upper1, cancel);
+    if(x1.width() == 0 || F1 > EPS)
+    {
+        if(x1.width() != 0)
+            out() << "There is no solution (sum of artificial variables is " << F1 << ")" << std::endl;
+        P.clear();
+        Q.clear();
+        return std::make_pair(0, Matrix());
+    }
+
+    // *PHASE TWO*
+    return artificial_phase_two(A, b, c, rows, A1, upper1, P1, Q1, at_upper1, P, Q, at_upper, cancel);
+}
+
+std::pair<double, Matrix> composite_simplex(const Matrix& A, const Matrix& b, const Matrix& c,
+                                            std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                                            const Matrix& upper, std::vector<bool>& at_upper,
+                                            const std::atomic<bool>* cancel)
+{
+    auto n = A.width();
+    Matrix A1, upper1;
+    std::vector<unsigned> P1, Q1;
+    std::vector<bool> at_upper1;
+    auto rows = add_artificials(A, b, upper, A1, upper1, P1, Q1, at_upper1);
+    unsigned k = rows.size();
+
+    // Weight of objective: omega*max|c(j)| = COMPOSITE_WEIGHT, so at start one unit of
+    // infeasibility costs as much as COMPOSITE_WEIGHT units of largest cost
+    double c_max = 0.0;
+    for(unsigned j=0; j<n; j++)
+        c_max = std::max(c_max, std::fabs(c.at(0, j)));
+    double omega = (c_max > 0.0) ? COMPOSITE_WEIGHT/c_max : 0.0;
+
+    // *COMPOSITE PHASE*
+    // (min) w1 + w2 + ... + wK + omega*c*x
+    // Ax + Ww + s = b, all variables in their bounds
+    // Every round continues from base of previous round: if optimal base still has
+    // infeasibility (sum of w > 0), omega is divided by COMPOSITE_DECREASE, with omega below
+    // COMPOSITE_MIN_WEIGHT (or unbounded round) omega = 0 (pure phase one)
+    unsigned round = 0;
+    while(k > 0)
+    {
+        Matrix c1(1, n+k);
+        for(unsigned j=0; j<n; j++)
+            c1.at(0, j) = omega*c.at(0, j);
+        for(unsigned a=0; a<k; a++)
+            c1.at(0, n+a) = 1;
+
+        out() << BAR << std::endl;
+        out() << "Composite round " << round++ << ": " << k << " artificial variables, omega = " << omega << std::endl;
+        auto x1 = residual_simplex(A1, b, c1, P1, Q1, upper1, at_upper1, cancel).second;
+        if(is_cancelled(cancel))
+            return std::make_pair(0, Matrix());
+        if(x1.width() == 0)
+        {
+            if(omega == 0.0)
+                return std::make_pair(0, Matrix());
+            out() << "Composite objective is unbounded => omega = 0" << std::endl;
+            omega = 0.0;
+            continue;
+        }
+
+        double infeasibility = 0.0;
+        for(unsigned a=0; a<k; a++)
+            infeasibility += x1.at(0, n+a);
+        out() << "Sum of artificial variables: " << infeasibility << std::endl;
+        if(infeasibility <= EPS)
+            break;
+        if(omega == 0.0)
+        {
+            out() << "There is no solution (sum of artificial variables is " << infeasibility << ")" << std::endl;
+            P.clear();
+            Q.clear();
+            return std::make_pair(0, Matrix());
+        }
+        omega /= COMPOSITE_DECREASE;
+        if(omega < COMPOSITE_MIN_WEIGHT)
+            omega = 0.0;
+    }
+
+    // *PHASE TWO* (only cost, starts from feasible base of composite phase)
+    return artificial_phase_two(A, b, c, rows, A1, upper1, P1, Q1, at_upper1, P, Q, at_upper, cancel);
+}
+
+// Returns status of base P (with nonbase variables at bounds given by at_upper) for system Ax + s = b, (min) c*x
+BasisStatus get_basis_status(const Matrix& A, const Matrix& b, const Matrix& c,
+                             const std::vector<unsigned>& P, const std::vector<unsigned>& Q,
+                             const Matrix& upper, const std::vector<bool>& at_upper)
+{
+    try
+    {
+        auto x = get_x(A, b, P, Q, upper, at_upper);
+        if(get_max_violation(x, P, upper) == STOP)
+            return BasisStatus::PRIMAL_FEASIBLE;
+
+        auto u = LU(get_B(A, P)).solve_transposed(get_Cb(c, P));
+        auto r = get_r(A, c, u, Q);
+        if(get_first_improving(r, Q, upper, at_upper) == STOP)
+            return BasisStatus::DUAL_FEASIBLE;
+        return BasisStatus::INFEASIBLE;
+    }
+    catch(const std::invalid_argument&)
+    {
+        return BasisStatus::SINGULAR;
+    }
+}
+
+// Continues from base P (warm start):
+// residual simplex if base is primal feasible, dual simplex if base is dual feasible
+// Returns false if base is singular or infeasible (nothing is solved)
+bool solve_from_basis(const Matrix& A, const Matrix& b, const Matrix& c,
+                      std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                      const Matrix& upper, std::vector<bool>& at_upper, double& F, Matrix& x,
+                      const std::atomic<bool>* cancel)
+{
+    switch(get_basis_status(A, b, c, P, Q, upper, at_upper))
+    {
+        case BasisStatus::PRIMAL_FEASIBLE:
+            out() << "Base is primal feasible (0 <= xb <= u) => residual simplex" << std::endl;
+            std::tie(F, x) = residual_simplex(A, b, c, P, Q, upper, at_upper, cancel);
+            return true;
+        case BasisStatus::DUAL_FEASIBLE:
+            out() << "Base is dual feasible => dual simplex" << std::endl;
+            std::tie(F, x) = dual_simplex(A, b, c, P, Q, upper, at_upper, cancel);
+            return true;
+        default:
+            out() << "Base is singular or infeasible!" << std::endl;
+            return false;
+    }
+}
+
+// Basis file:
+// N M              (A width, A height)
+// P1 P2 ... PM     (base columns)
+// K U1 U2 ... UK   (nonbase columns at upper bound)
+bool save_basis(const std::string& path, const std::vector<unsigned>& P, const std::vector<bool>& at_upper)
+{
+    std::ofstream output(path);
+    if(output.fail())
+        return false;
+    output << at_upper.size() << " " << P.size() << std::endl;
+    for(auto p: P)
+        output << p << " ";
+    output << std::endl;
+
+    std::vector<unsigned> U;
+    for(unsigned j=0; j<at_upper.size(); j++)
+        if(at_upper.at(j))
+            U.push_back(j);
+    output << U.size() << " ";
+    for(auto u: U)
+        output << u << " ";
+    output << std::endl;
+    return true;
+}
+
+// Returns empty P if file does not exist or base does not match system dimensions
+std::vector<unsigned> load_basis(const std::string& path, unsigned height, unsigned width, std::vector<bool>& at_upper)
+{
+    std::ifstream input(path);
+    if(input.fail())
+        return std::vector<unsigned>();
+
+    unsigned n, m;
+    input >> n >> m;
+    if(input.fail() || n != width || m != height)
+        return std::vector<unsigned>();
+
+    std::vector<unsigned> P(m);
+    std::vector<bool> is_base(width, false);
+    for(auto& p: P)
+    {
+        input >> p;
+        if(input.fail() || p >= width || is_base.at(p))
+            return std::vector<unsigned>();
+        is_base.at(p) = true;
+    }
+
+    // (optional) nonbase columns at upper bound
+    at_upper.assign(width, false);
+    unsigned k;
+    if(input >> k)
+        for(unsigned i=0; i<k; i++)
+        {
+            unsigned j;
+            input >> j;
+            if(input.fail() || j >= width || is_base.at(j))
+                return std::vector<unsigned>();
+            at_upper.at(j) = true;
+        }
+    return P;
+}
+
+std::vector<unsigned> get_Q(const std::vector<unsigned>& P, unsigned width)
+{
+    std::vector<bool> is_base(width, false);
+    for(auto p: P)
+        is_base.at(p) = true;
+    std::vector<unsigned> Q;
+    for(unsigned j=0; j<width; j++)
+        if(!is_base.at(j))
+            Q.push_back(j);
+    return Q;
+}
+
+void show_system(const Matrix& A, const Matrix& b, const Matrix& c)
+{
+    out() << "c: " << c << std::endl;
+    out() << "A:" << std::endl;
+    out() << A << std::endl;
+    out() << "b: " << b << std::endl << std::endl;
+}
+
+// Scale factors are rounded to the nearest power of 2 so scaling and unscaling
+// do not introduce any rounding error (only the exponent of a double changes)
+double round_to_power_of_two(double value)
+{
+    return std::exp2(std::round(std::log2(value)));
+}
+
+// Ratio of largest and smallest absolute non-zero value in A (1 is ideal)
+double scaling_ratio(const Matrix& A)
+{
+    double min_value = INF, max_value = 0.0;
+    for(unsigned i=0; i<A.height(); i++)
+        for(unsigned j=0; j<A.width(); j++)
+        {
+            double value = std::fabs(A.at(i, j));
+            if(value < EPS*EPS)
+                continue;
+            min_value = std::min(min_value, value);
+            max_value = std::max(max_value, value);
+        }
+    return (max_value > 0.0) ? max_value/min_value : 1.0;
+}
+
+void scale_rows(Matrix& A, Matrix& b, Matrix& row_scale, const Matrix& factors)
+{
+    for(unsigned i=0; i<A.height(); i++)
+    {
+        double r = factors.at(0, i);
+        for(unsigned j=0; j<A.width(); j++)
+            A.at(i, j) *= r;
+        b.at(0, i) *= r;
+        row_scale.at(0, i) *= r;
+    }
+}
+
+void scale_columns(Matrix& A, Matrix& c, Matrix& col_scale, const Matrix& factors)
+{
+    for(unsigned j=0; j<A.width(); j++)
+    {
+        double s = factors.at(0, j);
+        for(unsigned i=0; i<A.height(); i++)
+            A.at(i, j) *= s;
+        c.at(0, j) *= s;
+        col_scale.at(0, j) *= s;
+    }
+}
+
+// Scaling: A' = R*A*S, b' = R*b, c' = c*S where R and S are diagonal matrices
+// (row_scale and col_scale). Solution of scaled system x' gives x = S*x' and
+// objective value stays the same because c'x' = c*S*S^(-1)*x = cx.
+// Step1: geometric mean scaling - every row (column) is divided by sqrt(min*max)
+//        of its absolute values, repeated while ratio max/min keeps improving
+// Step2: equilibration - every row (column) is divided by its max absolute value
+std::pair<Matrix, Matrix> scale_system(Matrix& A, Matrix& b, Matrix& c)
+{
+    const unsigned max_passes = 8;
+    auto m = A.height();
+    auto n = A.width();
+    Matrix row_scale(1, m, 1.0), col_scale(1, n, 1.0);
+
+    // Step1:
+    double ratio = scaling_ratio(A);
+    for(unsigned pass=0; pass<max_passes; pass++)
+    {
+        Matrix row_factors(1, m, 1.0), col_factors(1, n, 1.0);
+        for(unsigned i=0; i<m; i++)
+        {
+            double min_value = INF, max_value = 0.0;
+            for(unsigned j=0; j<n; j++)
+            {
+                double value = std::fabs(A.at(i, j));
+                if(value < EPS*EPS)
+                    continue;
+                min_value = std::min(min_value, value);
+                max_value = std::max(max_value, value);
+            }
+            if(max_value > 0.0)
+                row_factors.at(0, i) = round_to_power_of_two(1.0/std::sqrt(min_value*max_value));
+        }
+        scale_rows(A, b, row_scale, row_factors);
+
+        for(unsigned j=0; j<n; j++)
+        {
+            double min_value = INF, max_value = 0.0;
+            for(unsigned i=0; i<m; i++)
+            {
+                double value = std::fabs(A.at(i, j));
+                if(value < EPS*EPS)
+                    continue;
+                min_value = std::min(min_value, value);
+                max_value = std::max(max_value, value);
+            }
+            if(max_value > 0.0)
+                col_factors.at(0, j) = round_to_power_of_two(1.0/std::sqrt(min_value*max_value));
+        }
+        scale_columns(A, c, col_scale, col_factors);
+
+        // Stopping when there is no significant (10%) improvement
+        double new_ratio = scaling_ratio(A);
+        if(new_ratio > 0.9*ratio)
+            break;
+        ratio = new_ratio;
+    }
+
+    // Step2:
+    Matrix row_factors(1, m, 1.0), col_factors(1, n, 1.0);
+    for(unsigned i=0; i<m; i++)
+    {
+        double max_value = 0.0;
+        for(unsigned j=0; j<n; j++)
+            max_value = std::max(max_value, std::fabs(A.at(i, j)));
+        if(max_value > 0.0)
+            row_factors.at(0, i) = round_to_power_of_two(1.0/max_value);
+    }
+    scale_rows(A, b, row_scale, row_factors);
+
+    for(unsigned j=0; j<n; j++)
+    {
+        double max_value = 0.0;
+        for(unsigned i=0; i<m; i++)
+            max_value = std::max(max_value, std::fabs(A.at(i, j)));
+        if(max_value > 0.0)
+            col_factors.at(0, j) = round_to_power_of_two(1.0/max_value);
+    }
+    scale_columns(A, c, col_scale, col_factors);
+
+    return std::make_pair(row_scale, col_scale);
+}
+
+// x = S*x' for structural columns
+// Logical columns are scaled with row scale (R*A*S*x' + R*s = R*b, s' = R*s)
+Matrix unscale_x(const Matrix& x, const Matrix& row_scale, const Matrix& col_scale)
+{
+    auto n = col_scale.width();
+    Matrix result = x;
+    for(unsigned j=0; j<x.width(); j++)
+        if(j < n)
+            result.at(0, j) *= col_scale.at(0, j);
+        else
+            result.at(0, j) /= row_scale.at(0, j - n);
+    return result;
+}
@@ -0,0 +1,246 @@
+#ifndef __SIMPLEX__
+#define __SIMPLEX__
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <climits>
+#include <cfloat>
+#include <cmath>
+#include <iomanip>
+#include <tuple>
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <chrono>
+#include <random>
+#include "matrix.hpp"
+
+#define STOP ((unsigned)-1)
+#define INF DBL_MAX
+
+#define BAR "------------------------------------------------------"
+
+// precision: EPS
+#define EPS 0.0001
+
+// composite simplex: starting weight of objective (omega*max|c| = COMPOSITE_WEIGHT),
+// omega is divided by COMPOSITE_DECREASE after every round whose optimal base is not feasible,
+// below COMPOSITE_MIN_WEIGHT omega is 0 (phase one)
+#define COMPOSITE_WEIGHT 0.1
+#define COMPOSITE_DECREASE 10
+#define COMPOSITE_MIN_WEIGHT 1e-9
+
+// residual simplex factorizes base again after this many eta matrices (changes of base)
+#define ETA_REFACTOR 50
+
+// Anti-degeneracy: residual simplex perturbs b when at least PERTURB_RATIO of its pivots
+// (after PERTURB_MIN_PIVOTS pivots) had step 0, every base variable moves into its bounds
+// by PERTURBATION to 2*PERTURBATION (relative to max(1, |x|))
+#define PERTURB_MIN_PIVOTS 20
+#define PERTURB_RATIO 0.5
+#define PERTURBATION 0.001
+
+// Lexicographic simplex: ratios and components of columns that differ by at most LEX_TOLERANCE are
+// equal, reduced cost |r(j)| <= LEX_TOLERANCE is 0
+#define LEX_TOLERANCE 1e-9
+
+enum class BasisStatus { SINGULAR, PRIMAL_FEASIBLE, DUAL_FEASIBLE, INFEASIBLE };
+
+// Solvers check cancel flag (if it is given) at start of every iteration and
+// stop with empty result when it is set (cooperative cancellation, ex. concurrent solve)
+bool is_cancelled(const std::atomic<bool>* cancel);
+
+// Work done by solvers in current thread (ex. for benchmarks), every thread has its own counters:
+// iterations ~ simplex/barrier iterations, pivots ~ changes of base (degenerate_pivots ~ changes with
+// step 0), bound_flips ~ nonbase variable moved to its other bound, factorizations ~ LU factorizations
+// of B (Cholesky for barrier), ftran ~ solves of B*y = a, btran ~ solves of u*B = c
+// Densities (sum of non-zeros/size of every FTRAN/BTRAN result) and times of parts of iteration
+// (seconds) are collected only if statistics are turned on (set_stats)
+struct SimplexCounters {
+    unsigned long iterations = 0, pivots = 0, degenerate_pivots = 0, bound_flips = 0, factorizations = 0;
+    unsigned long ftran = 0, btran = 0;
+    double ftran_density = 0.0, btran_density = 0.0;
+    double pricing_time = 0.0, ratio_time = 0.0, solve_time = 0.0, update_time = 0.0, factorization_time = 0.0;
+};
+
+SimplexCounters& counters();
+
+SimplexCounters operator+(const SimplexCounters& a, const SimplexCounters& b);
+SimplexCounters operator-(const SimplexCounters& a, const SimplexCounters& b);
+
+// Statistics are turned on for all threads, when they are off every timer and density
+// only checks flag (counters are always counted)
+void set_stats(bool enabled);
+bool stats_enabled();
+
+// Perturbation (anti-degeneracy of residual simplex) is on by default for all threads,
+// random deltas come from generator with given seed (same seed ~ same iterations)
+void set_perturbation(bool enabled, unsigned seed = 1);
+bool perturbation_enabled();
+unsigned perturbation_seed();
+
+// Adds time spent in scope to timer (ex. counters().pricing_time) if statistics are on
+class ScopedTimer {
+private:
+    double* m_timer;
+    std::chrono::steady_clock::time_point m_start;
+
+public:
+    ScopedTimer(double& timer)
+        : m_timer(stats_enabled() ? &timer : nullptr)
+    {
+        if(m_timer)
+            m_start = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedTimer()
+    {
+        if(m_timer)
+            *m_timer += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+};
+
+// FTRAN/BTRAN result is counted (density is added if statistics are on)
+void count_ftran(const Matrix& y);
+void count_btran(const Matrix& u);
+
+// Summary table (counters, average densities, time of every part and share of total seconds)
+void print_stats(std::ostream& stream, const SimplexCounters& stats, double seconds);
+// Same values as JSON object
+void write_stats_json(std::ostream& stream, const SimplexCounters& stats, double seconds);
+
+// Output of solvers, every thread can redirect its own output (ex. concurrent solve), default is std::cout
+std::ostream& out();
+void set_output(std::ostream& stream);
+
+template<typename T>
+void vector_print(const std::vector<T>& v)
+{
+    for(auto e: v)
+        out() << e << " ";
+    out() << std::endl;
+}
+
+// *LOGICAL VARIABLES* (column N+i of system [A | E] is unit vector e(i) with cost 0)
+
+bool is_logical(const Matrix& A, unsigned j);
+
+Matrix get_column(const Matrix& A, unsigned j);
+
+double get_cost(const Matrix& c, unsigned j);
+
+double dot_column(const Matrix& A, const Matrix& u, unsigned j);
+
+double bound_violation(double value, double upper);
+
+unsigned get_max_violation(const Matrix& x, const std::vector<unsigned>& P, const Matrix& upper);
+
+std::pair<std::vector<unsigned>, std::vector<unsigned> >
+crash_basis(const Matrix& A, const Matrix& b, const Matrix& upper, std::vector<bool>& at_upper);
+
+Matrix get_B(const Matrix& A, const std::vector<unsigned>& P);
+
+Matrix get_Cb(const Matrix& c, const std::vector<unsigned>& P);
+
+Matrix get_r(const Matrix& A, const Matrix& c, const Matrix& u, const std::vector<unsigned>& Q);
+
+unsigned get_first_improving(const Matrix& r, const std::vector<unsigned>& Q, const Matrix& upper,
+                             const std::vector<bool>& at_upper);
+
+Matrix get_rhs(const Matrix& A, const Matrix& b, const std::vector<unsigned>& Q,
+               const Matrix& upper, const std::vector<bool>& at_upper, Matrix& x);
+
+Matrix get_x(const Matrix& A, const Matrix& b, const std::vector<unsigned>& P, const std::vector<unsigned>& Q,
+             const Matrix& upper, const std::vector<bool>& at_upper);
+
+// Anti-degeneracy: base variables of x move into their bounds (b' = b + B*e), returns number of moved variables
+unsigned perturb(Matrix& x, const std::vector<unsigned>& P, const Matrix& upper, std::mt19937& generator);
+
+std::tuple<double, unsigned, bool> get_t_opt(const Matrix& x, const Matrix& y, const std::vector<unsigned>& P,
+                                             const Matrix& upper, unsigned l, double direction);
+
+void update_x(Matrix& x, const Matrix& y, unsigned l, const std::vector<unsigned>& P, double t);
+
+void update_P_Q(std::vector<unsigned>& P, std::vector<unsigned>& Q, unsigned t_index, unsigned l);
+
+std::pair<double, Matrix> residual_simplex(const Matrix& A, const Matrix& b, const Matrix& c,
+                                           std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                                           const Matrix& upper, std::vector<bool>& at_upper,
+                                           const std::atomic<bool>* cancel = nullptr);
+
+// Lexicographic dual simplex (lexicographic = true): column of nonbase variable j is
+// R(j) = (|r(j)|, dx(0)/dt, dx(1)/dt, ..., dx(N+M-1)/dt) (t ~ move of x(j) from its bound), entering
+// variable has lexicographically smallest R(j)/|alpha(j)| (no bound flips), so base that is optimal
+// for lexicographic objective (c*x, x(0), x(1), ...) stays lexicographically dual feasible and
+// dual simplex can't cycle on degenerate vertices (Gomory's cuts)
+// Factorization of base (basis != nullptr): if it is given for B of P, dual simplex starts from it
+// instead of factorizing B (ex. factorization of last base bordered by new rows), optimal B is left in it
+std::pair<double, Matrix> dual_simplex(const Matrix& A, const Matrix& b, const Matrix& c,
+                                       std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                                       const Matrix& upper, std::vector<bool>& at_upper,
+                                       const std::atomic<bool>* cancel = nullptr, bool lexicographic = false,
+                                       std::optional<EtaFile>* basis = nullptr);
+
+// Lexicographic optimum: optimal base changes (primal pivots with Bland's rule) while some nonbase
+// variable with r(j) = 0 has lexicographically negative column (dx(0)/dt, ..., dx(N+M-1)/dt), so x
+// stays optimal and becomes lexicographically smallest optimal vertex
+// Returns number of pivots, x is solution of new base
+unsigned lexicographic_optimum(const Matrix& A, const Matrix& b, const Matrix& c,
+                               std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                               const Matrix& upper, std::vector<bool>& at_upper, Matrix& x);
+
+// Two-phase simplex: phase one minimizes sum of artificial variables (added only for rows
+// where logical variable can't be in starting base), phase two continues from base of phase one
+// Returns empty x if there is no solution (P is empty if system has no feasible solution)
+std::pair<double, Matrix> two_phase_simplex(const Matrix& A, const Matrix& b, const Matrix& c,
+                                            std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                                            const Matrix& upper, std::vector<bool>& at_upper,
+                                            const std::atomic<bool>* cancel = nullptr);
+
+// Composite simplex (single phase): artificial variables of two-phase simplex are kept, but
+// objective is sum of artificial variables + omega*c*x, so cost is used before base is feasible,
+// omega is decreased while optimal base of composite objective is not feasible
+// When all artificial variables are 0, phase two continues from that base with c
+// Returns empty x if there is no solution (P is empty if system has no feasible solution)
+std::pair<double, Matrix> composite_simplex(const Matrix& A, const Matrix& b, const Matrix& c,
+                                            std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                                            const Matrix& upper, std::vector<bool>& at_upper,
+                                            const std::atomic<bool>* cancel = nullptr);
+
+void show_system(const Matrix& A, const Matrix& b, const Matrix& c);
+
+// *WARM START*
+
+BasisStatus get_basis_status(const Matrix& A, const Matrix& b, const Matrix& c,
+                             const std::vector<unsigned>& P, const std::vector<unsigned>& Q,
+                             const Matrix& upper, const std::vector<bool>& at_upper);
+
+bool solve_from_basis(const Matrix& A, const Matrix& b, const Matrix& c,
+                      std::vector<unsigned>& P, std::vector<unsigned>& Q,
+                      const Matrix& upper, std::vector<bool>& at_upper, double& F, Matrix& x,
+                      const std::atomic<bool>* cancel = nullptr);
+
+bool save_basis(const std::string& path, const std::vector<unsigned>& P, const std::vector<bool>& at_upper);
+
+std::vector<unsigned> load_basis(const std::string& path, unsigned height, unsigned width, std::vector<bool>& at_upper);
+
+std::vector<unsigned> get_Q(const std::vector<unsigned>& P, unsigned width);
+
+// *SCALING*
+
+double round_to_power_of_two(double value);
+
+double scaling_ratio(const Matrix& A);
+
+void scale_rows(Matrix& A, Matrix& b, Matrix& row_scale, const Matrix& factors);
+
+void scale_columns(Matrix& A, Matrix& c, Matrix& col_scale, const Matrix& factors);
+
+std::pair<Matrix, Matrix> scale_system(Matrix& A, Matrix& b, Matrix& c);
+
+Matrix unscale_x(const Matrix& x, const Matrix& row_scale, const Matrix& col_scale);
+
+#endif
\ No newline at end of file
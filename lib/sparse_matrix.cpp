@@ -0,0 +1,118 @@
+#include "sparse_matrix.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+SparseMatrix::SparseMatrix()
+    : SparseMatrix(0, 0)
+{}
+
+SparseMatrix::SparseMatrix(unsigned height, unsigned width)
+    : m_height(height), m_width(width), m_start(width+1, 0)
+{}
+
+SparseMatrix::SparseMatrix(unsigned height, unsigned width, std::vector<Triplet> triplets)
+    : SparseMatrix(height, width)
+{
+    std::sort(triplets.begin(), triplets.end(), [](const Triplet& a, const Triplet& b) {
+        return (a.col != b.col) ? a.col < b.col : a.row < b.row;
+    });
+
+    m_index.reserve(triplets.size());
+    m_value.reserve(triplets.size());
+    for(unsigned k=0; k<triplets.size(); k++)
+    {
+        const Triplet& t = triplets[k];
+        if(t.row >= height || t.col >= width)
+            throw std::invalid_argument("Triplet is out of matrix bounds!");
+
+        double value = t.value;
+        while(k+1 < triplets.size() && triplets[k+1].row == t.row && triplets[k+1].col == t.col)
+            value += triplets[++k].value;
+        if(value == 0.0)
+            continue;
+        m_index.push_back(t.row);
+        m_value.push_back(value);
+        m_start[t.col+1]++;
+    }
+    for(unsigned j=0; j<width; j++)
+        m_start[j+1] += m_start[j];
+}
+
+SparseMatrix::SparseMatrix(const Matrix& M)
+    : SparseMatrix(M.height(), M.width())
+{
+    for(unsigned j=0; j<m_width; j++)
+    {
+        for(unsigned i=0; i<m_height; i++)
+            if(M.at(i, j) != 0.0)
+            {
+                m_index.push_back(i);
+                m_value.push_back(M.at(i, j));
+            }
+        m_start[j+1] = m_index.size();
+    }
+}
+
+unsigned SparseMatrix::height() const
+{
+    return m_height;
+}
+
+unsigned SparseMatrix::width() const
+{
+    return m_width;
+}
+
+unsigned SparseMatrix::nonzeros() const
+{
+    return m_value.size();
+}
+
+unsigned SparseMatrix::start(unsigned j) const
+{
+    return m_start.at(j);
+}
+
+unsigned SparseMatrix::end(unsigned j) const
+{
+    return m_start.at(j+1);
+}
+
+unsigned SparseMatrix::index(unsigned k) const
+{
+    return m_index.at(k);
+}
+
+double SparseMatrix::value(unsigned k) const
+{
+    return m_value.at(k);
+}
+
+double SparseMatrix::at(unsigned i, unsigned j) const
+{
+    if(i >= m_height || j >= m_width)
+        throw std::out_of_range("Index is out of matrix bounds!");
+    auto first = m_index.begin() + m_start[j];
+    auto last = m_index.begin() + m_start[j+1];
+    auto it = std::lower_bound(first, last, i);
+    if(it == last || *it != i)
+        return 0.0;
+    return m_value[it - m_index.begin()];
+}
+
+Matrix SparseMatrix::to_dense() const
+{
+    Matrix M(m_height, m_width);
+    for(unsigned j=0; j<m_width; j++)
+        for(unsigned k=m_start[j]; k<m_start[j+1]; k++)
+            M.at(m_index[k], j) = m_value[k];
+    return M;
+}
+
+std::ostream& operator<<(std::ostream& out, const SparseMatrix& M)
+{
+    for(unsigned j=0; j<M.m_width; j++)
+        for(unsigned k=M.m_start[j]; k<M.m_start[j+1]; k++)
+            out << "(" << M.m_index[k] << ", " << j << "): " << M.m_value[k] << std::endl;
+    return out;
+}
@@ -0,0 +1,50 @@
+#ifndef __SPARSE_MATRIX__
+#define __SPARSE_MATRIX__
+
+#include <vector>
+#include <iostream>
+#include "matrix.hpp"
+
+// (row, column, value) entry used to build SparseMatrix
+struct Triplet {
+    unsigned row, col;
+    double value;
+};
+
+// Compressed sparse column matrix:
+// values of column j are value[start[j]] ... value[start[j+1]-1] (rows are in index[...], sorted)
+class SparseMatrix {
+private:
+    unsigned m_height, m_width;
+    std::vector<unsigned> m_start, m_index;
+    std::vector<double> m_value;
+
+public:
+    // init: A(0, 0)
+    SparseMatrix();
+    // init: A(height, width) without non-zero values
+    SparseMatrix(unsigned height, unsigned width);
+    // init: A(height, width) from triplets, values with same (row, col) are added, zeros are removed
+    SparseMatrix(unsigned height, unsigned width, std::vector<Triplet> triplets);
+    // init: non-zero values of dense matrix
+    SparseMatrix(const Matrix& M);
+
+    unsigned height() const;
+    unsigned width() const;
+    unsigned nonzeros() const;
+
+    // column j: index[k], value[k] for k in [start(j), end(j))
+    unsigned start(unsigned j) const;
+    unsigned end(unsigned j) const;
+    unsigned index(unsigned k) const;
+    double value(unsigned k) const;
+
+    // indexing (binary search in column j)
+    double at(unsigned i, unsigned j) const;
+
+    Matrix to_dense() const;
+
+    friend std::ostream& operator<<(std::ostream& out, const SparseMatrix& M);
+};
+
+#endif